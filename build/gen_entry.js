@@ -82,6 +82,48 @@ const entry_base =
             default: "",
             readOnly: false
         },
+        {
+            name: "Private Engine Pool Size",
+            desc: "Number of Private engine instances (0-10) to keep initialized in the background, ready to be used by new Private scripts without a startup delay. " +
+                "Each spare engine uses some memory. Set to 0 to disable.",
+            type: "number",
+            default: "1",
+            minValue: 0,
+            maxValue: 10,
+            readOnly: false
+        },
+        {
+            name: "Private Engine Threads",
+            desc: "Number of worker threads shared by all Private engine instances. With many Private engines, sharing a few threads uses less memory and fewer context switches. " +
+                "Scripts within each engine still run one at a time, but scripts in engines sharing a thread will wait for each other. " +
+                "Set to 0 to give each Private engine its own thread, or -1 to use one thread per CPU core. Applies to engines created after the change.",
+            type: "number",
+            default: "0",
+            minValue: -1,
+            maxValue: 64,
+            readOnly: false
+        },
+        {
+            name: "Shared Engine Count",
+            desc: "Number of Shared engine instances (1-16) which script instances using the \"Shared\" scope are distributed across, so they can run in parallel on multiple CPU cores. " +
+                "Each instance name always uses the same engine, but instances in different Shared engines do not share global variables; use DSE.setSharedValue() and DSE.sharedValue() to exchange data. " +
+                "The default of 1 keeps all Shared instances in one engine. Takes effect after a plugin restart.",
+            type: "number",
+            default: "1",
+            minValue: 1,
+            maxValue: 16,
+            readOnly: false
+        },
+        {
+            name: "Script Evaluation Time Limit (ms)",
+            desc: "Maximum time any single script evaluation may run before it is interrupted with an error, so that one runaway script can not block others. " +
+                "Set to 0 to disable the limit.",
+            type: "number",
+            default: "10000",
+            minValue: 0,
+            maxValue: 3600000,
+            readOnly: false
+        },
         {
             name: "Settings Version",
             desc: "Read-only property to track the last installed plugin version.",
@@ -164,6 +206,30 @@ const entry_base =
                     default : "Unknown",
                     valueChoices: ["Stopped", "Starting", "Started"]
                 },
+                {
+                    id: PLUGIN_ID + ".state.evalTimeoutCount",
+                    type: "text",
+                    desc : SHORT_NAME + ": Cumulative count of evaluations interrupted by time limit",
+                    default : "0"
+                },
+                {
+                    id: PLUGIN_ID + ".state.evalMaxDuration",
+                    type: "text",
+                    desc : SHORT_NAME + ": Longest script evaluation time (ms)",
+                    default : "0"
+                },
+                {
+                    id: PLUGIN_ID + ".state.enginesHeapSize",
+                    type: "text",
+                    desc : SHORT_NAME + ": Total memory heap size of all script engines (MB)",
+                    default : "0"
+                },
+                {
+                    id: PLUGIN_ID + ".state.gcCount",
+                    type: "text",
+                    desc : SHORT_NAME + ": Cumulative count of scheduled garbage collections",
+                    default : "0"
+                },
             ],
             actions: [],
             connectors: [],
@@ -347,6 +413,19 @@ function appendHoldOptionData(id, data) {
     return format;
 }
 
+function appendQueueOptionData(id, data) {
+    let format = `| Eval\n| Queue{${data.length}}`;
+    data.push(
+        makeChoiceData(id + ".queue", "Evaluation Queue Policy", [
+            "Default",
+            "Queue All",
+            "Latest Wins",
+            "Drop New",
+        ]),
+    );
+    return format;
+}
+
 // --------------------------------------
 // Action creation functions
 
@@ -364,9 +443,10 @@ function addEvalAction(name)
     format += appendScopeData(id, data);
     format += appendStateOptionData(id, data);
     const cdata = data.map(a => ({...a}));
-    addConnector(id, name, descript, format + appendPersistOnlyOptionData(id, cdata), cdata);
+    addConnector(id, name, descript, format + appendPersistOnlyOptionData(id, cdata) + appendQueueOptionData(id, cdata), cdata);
     format += appendPersistOptionData(id, data);
     format += appendHoldOptionData(id, data);
+    format += appendQueueOptionData(id, data);
     addAction(id, name, descript, format, data, true);
 }
 
@@ -386,6 +466,7 @@ function addScriptAction(name)
     format += appendStateOptionData(id, data);
     format += appendPersistOptionData(id, data);
     format += appendHoldOptionData(id, data);
+    format += appendQueueOptionData(id, data);
     addAction(id, name, descript, format, data, true);
     // No connector for script types, too much I/O
 }
@@ -406,9 +487,10 @@ function addModuleAction(name)
     format += appendScopeData(id, data);
     format += appendStateOptionData(id, data);
     const cdata = data.map(a => ({...a}));
-    addConnector(id, name, descript, format + appendPersistOnlyOptionData(id, cdata), cdata);
+    addConnector(id, name, descript, format + appendPersistOnlyOptionData(id, cdata) + appendQueueOptionData(id, cdata), cdata);
     format += appendPersistOptionData(id, data);
     format += appendHoldOptionData(id, data);
+    format += appendQueueOptionData(id, data);
     addAction(id, name, descript, format, data, true);
 }
 
@@ -1,4 +1,4 @@
-// Minifies JavaScript sources into one file.
+// Minifies JavaScript sources into one file, except for the lazily loaded library modules which are each minified into their own <name>.min.js file.
 // Uses babel, which is expected to be either installed in the build tree or globally with NODE_PATH set up.
 // Current node global module path can be obtained with `npm root --quiet --location=global`
 // Windows: FOR /F "tokens=*" %g IN ('npm root --quiet --location=global') do (SET NODE_PATH=%g)
@@ -20,6 +20,23 @@ const babel = await import('file:///'+ NODE_PATH + '/@babel/core/lib/index.js');
 
 const script_dir = process.argv0.indexOf("node") > -1 ? dirname(process.argv[1]) : dirname(process.argv0);
 
+// Library modules which the script engine loads on first use, each from its own file.
+// Must match the g_lazyLibraryModules list in src/ScriptEngine.cpp.
+const lazy_modules = [ "color", "env", "fetch", "sprintf", "stringformat" ];
+
+function minifySource(fn)
+{
+  console.log("Reading source file " + fn);
+  const js = readFileSync(fn).toString();
+  const minified = babel.transform(js,
+  {
+    presets: [["babel-preset-minify", { builtIns: false }]],
+    plugins: ["@babel/plugin-syntax-import-meta"],
+    comments: false
+  });
+  return minified.code;
+}
+
 export default function minify(src = null, dst = null)
 {
   src = src || resolve(script_dir, "../src/resources/scripts/");
@@ -31,16 +48,15 @@ export default function minify(src = null, dst = null)
   while ((dirent = dir.readSync()) !== null) {
     if (!dirent.name.endsWith('.js') || dirent.name.endsWith('.min.js') /*|| dirent.name == 'global.js'*/)
       continue;
+    const name = dirent.name.slice(0, -3);
     const fn = join(src, dirent.name);
-    console.log("Reading source file " + fn);
-    const js = readFileSync(fn).toString();
-    const minified = babel.transform(js,
-    {
-      presets: [["babel-preset-minify", { builtIns: false }]],
-      plugins: ["@babel/plugin-syntax-import-meta"],
-      comments: false
-    });
-    code += '\n' + minified.code;
+    if (lazy_modules.includes(name)) {
+      const mod_dst = join(src, name + ".min.js");
+      writeFileSync(mod_dst, minifySource(fn));
+      console.log("Wrote minified module to " + mod_dst);
+      continue;
+    }
+    code += '\n' + minifySource(fn);
   }
 
   writeFileSync(dst, code);
@@ -0,0 +1,737 @@
+/*
+Dynamic Script Engine Plugin for Touch Portal
+Copyright Maxim Paperno; all rights reserved.
+
+This file may be used under the terms of the GNU
+General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+A copy of the GNU General Public License is available at <http://www.gnu.org/licenses/>.
+
+This project may also use 3rd-party Open Source software under the terms
+of their respective licenses. The copyright notice above does not apply
+to any 3rd-party components used within.
+*/
+
+#include "ConnectorData.h"
+
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QCache>
+#include <QJsonDocument>
+#include <QMutex>
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+// Maximum number of compiled queries kept for reuse.
+#define CONNECTOR_QUERY_CACHE_CAPACITY  64
+
+namespace {
+
+// Decodes one UTF-8 code point at `pos` and advances past it. Invalid bytes are returned as-is, one at a time.
+char32_t nextCodePoint(QByteArrayView s, qsizetype &pos)
+{
+	const uchar c = uchar(s.at(pos++));
+	int extra = c >= 0xF0 ? 3 : c >= 0xE0 ? 2 : c >= 0xC0 ? 1 : 0;
+	if (!extra || pos + extra > s.size())
+		return c;
+	char32_t cp = c & (0x3F >> extra);
+	for (; extra; --extra) {
+		const uchar cc = uchar(s.at(pos));
+		if ((cc & 0xC0) != 0x80)
+			break;
+		cp = (cp << 6) | (cc & 0x3F);
+		++pos;
+	}
+	return cp;
+}
+
+// Case-sensitive pattern matching with the same syntax as SQLite's GLOB operator: `*` matches any string, `?` any one character, and `[...]`
+// any one character in the set (`[^...]` any one not in the set), with `a-z` style ranges. The pattern is compiled once into tokens which
+// can then be matched against any number of values without further allocation.
+class GlobMatcher
+{
+	public:
+		explicit GlobMatcher(QByteArrayView pattern) { compile(pattern); }
+
+		// True if the pattern has no wildcards, in which case it is an exact match for literal().
+		bool isLiteral() const { return m_valid && (m_tokens.empty() || (m_tokens.size() == 1 && m_tokens.front().type == Literal)); }
+		QByteArray literal() const { return m_tokens.empty() ? QByteArray() : m_tokens.front().text; }
+
+		bool match(QByteArrayView s) const
+		{
+			if (!m_valid)
+				return false;
+			const size_t nt = m_tokens.size();
+			const qsizetype n = s.size();
+			size_t t = 0;
+			qsizetype pos = 0;
+			// Only the most recent `*` ever needs to be backtracked to.
+			size_t starTok = nt;
+			qsizetype starPos = 0;
+			while (true) {
+				if (t < nt) {
+					const Token &tok = m_tokens[t];
+					switch (tok.type) {
+						case AnyString:
+							starTok = t++;
+							starPos = pos;
+							continue;
+
+						case Literal:
+							if (starTok + 1 == t) {
+								// Following a `*` the literal can be searched for directly.
+								const qsizetype at = s.indexOf(tok.text, pos);
+								if (at < 0)
+									return false;
+								starPos = at;
+								pos = at + tok.text.size();
+								++t;
+								continue;
+							}
+							if (s.sliced(pos).startsWith(tok.text)) {
+								pos += tok.text.size();
+								++t;
+								continue;
+							}
+							break;
+
+						case AnyChar:
+							if (pos < n) {
+								nextCodePoint(s, pos);
+								++t;
+								continue;
+							}
+							break;
+
+						case CharSet:
+							if (pos < n) {
+								qsizetype next = pos;
+								const char32_t c = nextCodePoint(s, next);
+								const bool found = std::any_of(tok.ranges.cbegin(), tok.ranges.cend(), [c](const auto &r) { return c >= r.first && c <= r.second; });
+								if (found != tok.negate) {
+									pos = next;
+									++t;
+									continue;
+								}
+							}
+							break;
+					}
+				}
+				else if (pos == n) {
+					return true;
+				}
+
+				// Mismatch or unmatched trailing text; let the last `*` consume one more character and retry what follows it.
+				if (starTok == nt)
+					return false;
+				if (starTok + 1 == nt)
+					return true;
+				if (starPos >= n)
+					return false;
+				nextCodePoint(s, starPos);
+				pos = starPos;
+				t = starTok + 1;
+			}
+		}
+
+	private:
+		enum TokenType : quint8 { Literal, AnyString, AnyChar, CharSet };
+		struct Token {
+			TokenType type;
+			bool negate = false;
+			QByteArray text;
+			std::vector<std::pair<char32_t, char32_t>> ranges;
+		};
+
+		void compile(QByteArrayView p)
+		{
+			QByteArray lit;
+			auto flush = [&]() {
+				if (!lit.isEmpty())
+					m_tokens.push_back({ Literal, false, std::exchange(lit, QByteArray()), {} });
+			};
+			const qsizetype n = p.size();
+			qsizetype i = 0;
+			while (i < n) {
+				const char c = p.at(i);
+				if (c == '*') {
+					flush();
+					if (m_tokens.empty() || m_tokens.back().type != AnyString)
+						m_tokens.push_back({ AnyString });
+					++i;
+				}
+				else if (c == '?') {
+					flush();
+					m_tokens.push_back({ AnyChar });
+					++i;
+				}
+				else if (c == '[') {
+					flush();
+					Token tok { CharSet };
+					if (++i < n && p.at(i) == '^') {
+						tok.negate = true;
+						++i;
+					}
+					// A leading `]` is part of the set.
+					if (i < n && p.at(i) == ']') {
+						tok.ranges.push_back({ ']', ']' });
+						++i;
+					}
+					bool closed = false;
+					while (i < n) {
+						if (p.at(i) == ']') {
+							closed = true;
+							++i;
+							break;
+						}
+						const char32_t lo = nextCodePoint(p, i);
+						if (i + 1 < n && p.at(i) == '-' && p.at(i + 1) != ']') {
+							++i;
+							tok.ranges.push_back({ lo, nextCodePoint(p, i) });
+						}
+						else {
+							tok.ranges.push_back({ lo, lo });
+						}
+					}
+					// Like SQLite, an unterminated set never matches anything.
+					if (!closed) {
+						m_valid = false;
+						return;
+					}
+					m_tokens.push_back(std::move(tok));
+				}
+				else {
+					lit += c;
+					++i;
+				}
+			}
+			flush();
+		}
+
+		std::vector<Token> m_tokens;
+		bool m_valid = true;
+};
+
+struct ConnectorEntry
+{
+	ConnectorRecord rec;
+	// Compact JSON of rec.otherData, which is what gets matched and sorted on.
+	QByteArray otherDataJson;
+	// The record's unique definition key (what used to be the table's primary key).
+	QByteArray key;
+	// Slider range from otherData, parsed once when stored (0 if not present).
+	float rangeMin = 0.0f;
+	float rangeMax = 0.0f;
+	quint64 seq;
+
+	// Text value of a column as it is searched and sorted.
+	QByteArray text(int col) const
+	{
+		switch (col) {
+			case ConnectorRecord::COL_ACTTYPE: return rec.actionType;
+			case ConnectorRecord::COL_NAME:    return rec.instanceName;
+			case ConnectorRecord::COL_EXPR:    return rec.expression;
+			case ConnectorRecord::COL_FILE:    return rec.file;
+			case ConnectorRecord::COL_ALIAS:   return rec.alias;
+			case ConnectorRecord::COL_CONNID:  return rec.connectorId;
+			case ConnectorRecord::COL_SHORTID: return rec.shortId;
+			case ConnectorRecord::COL_OTHER:   return otherDataJson;
+			case ConnectorRecord::COL_TS:      return QByteArray::number(rec.timestamp);
+			default:                           return QByteArray();
+		}
+	}
+
+	qint64 number(int col) const
+	{
+		switch (col) {
+			case ConnectorRecord::COL_INPTYPE: return (qint64)rec.inputType;
+			case ConnectorRecord::COL_INSTYPE: return (qint64)rec.instanceType;
+			case ConnectorRecord::COL_TS:      return rec.timestamp;
+			default:                           return 0;
+		}
+	}
+
+	bool isNumeric(int col) const { return col >= ConnectorRecord::COL_INPTYPE; }
+
+	// Approximate size of the record data, for statistics.
+	qint64 memoryBytes() const
+	{
+		return sizeof(ConnectorEntry) + otherDataJson.size() + key.size() + rec.actionType.size() + rec.instanceName.size() + rec.connectorId.size()
+		       + rec.shortId.size() + rec.expression.size() + rec.file.size() + rec.alias.size() + rec.otherData.count() * 32;
+	}
+
+	// Newest first, with the later insert winning for equal timestamps.
+	bool isNewerThan(const ConnectorEntry &other) const {
+		return rec.timestamp != other.rec.timestamp ? rec.timestamp > other.rec.timestamp : seq > other.seq;
+	}
+};
+
+// A query map compiled into filters and sort order.
+struct ConnectorQuery
+{
+	struct SortKey {
+		int column;
+		bool descending;
+	};
+
+	std::vector<std::pair<int, qint64>> enumFilters;
+	std::vector<std::pair<int, GlobMatcher>> globFilters;
+	std::vector<SortKey> order;
+	QString error;
+
+	explicit ConnectorQuery(const QMultiMap<QString, QVariant> &query)
+	{
+		const QStringList &cols = ConnectorRecord::columnNames();
+		for (auto const &[k, v] : query.asKeyValueRange()) {
+			if (k == QLatin1String("orderBy"))
+				continue;
+			const int col = cols.indexOf(k);
+			if (col < 0) {
+				error = QObject::tr("Unknown connector property name in search criteria: '%1'").arg(k);
+				return;
+			}
+			if (col == ConnectorRecord::COL_INPTYPE || col == ConnectorRecord::COL_INSTYPE) {
+				bool ok = false;
+				int e = v.toInt(&ok);
+				if (!ok && v.canConvert<QString>())
+					e = ConnectorRecord::enumProperties().value(k).keyToValue(qPrintable(v.toString()), &ok);
+				if (ok)
+					enumFilters.emplace_back(col, e);
+			}
+			else if (v.canConvert<QString>()) {
+				globFilters.emplace_back(col, GlobMatcher(v.toString().toUtf8()));
+			}
+		}
+
+		const QString orderBy = query.value(QStringLiteral("orderBy")).toString().trimmed();
+		if (orderBy.isEmpty())
+			return;
+		for (const QStringView term : QStringView(orderBy).split(',')) {
+			const QList<QStringView> parts = term.trimmed().split(' ', Qt::SkipEmptyParts);
+			int col = -1;
+			if (!parts.isEmpty() && parts.size() <= 2) {
+				for (int i = 0; col < 0 && i < cols.size(); ++i) {
+					if (!parts.first().compare(cols.at(i), Qt::CaseInsensitive))
+						col = i;
+				}
+				if (parts.size() == 2 && parts.last().compare(QLatin1String("ASC"), Qt::CaseInsensitive) && parts.last().compare(QLatin1String("DESC"), Qt::CaseInsensitive))
+					col = -1;
+			}
+			if (col < 0) {
+				error = QObject::tr("Invalid 'orderBy' term in search criteria: '%1'").arg(term.trimmed());
+				return;
+			}
+			order.push_back({ col, parts.size() == 2 && !parts.last().compare(QLatin1String("DESC"), Qt::CaseInsensitive) });
+		}
+	}
+
+	bool matches(const ConnectorEntry &e) const
+	{
+		for (const auto &[col, val] : enumFilters) {
+			if (e.number(col) != val)
+				return false;
+		}
+		for (const auto &[col, glob] : globFilters) {
+			if (!glob.match(e.text(col)))
+				return false;
+		}
+		return true;
+	}
+
+	bool lessThan(const ConnectorEntry *a, const ConnectorEntry *b) const
+	{
+		for (const SortKey &sk : order) {
+			int cmp;
+			if (a->isNumeric(sk.column)) {
+				const qint64 na = a->number(sk.column), nb = b->number(sk.column);
+				cmp = na < nb ? -1 : na > nb ? 1 : 0;
+			}
+			else {
+				cmp = a->text(sk.column).compare(b->text(sk.column));
+			}
+			if (cmp)
+				return sk.descending ? cmp > 0 : cmp < 0;
+		}
+		return a->isNewerThan(*b);
+	}
+};
+
+// One version of the stored records with all their indexes. Published versions are never modified, so any number of readers can search one
+// without locking. Every insert writes to all of the containers, so building the next version detaches (deep copies) each of them, which costs
+// O(total records) per published batch regardless of how few records it changes. This is why writers publish whole batches at a time.
+struct ConnectorSnapshot
+{
+	// Records by their insertion sequence number, which is what all the indexes refer to.
+	QHash<quint64, ConnectorEntry> entries;
+	QHash<QByteArray, quint64> byShortId;
+	QHash<QByteArray, quint64> byKey;
+	QMultiHash<QByteArray, quint64> byInstance;
+	QMultiHash<QByteArray, quint64> byAction;
+	QMap<std::pair<qint64, quint64>, quint64> byTime;
+	quint64 lastSeq = 0;
+	quint64 version = 0;
+	qint64 dataBytes = 0;
+
+	void insert(ConnectorEntry &&e)
+	{
+		e.seq = ++lastSeq;
+		// Same as the REPLACE INTO semantics of the old table, either unique constraint replaces an existing record.
+		if (const quint64 seq = byShortId.value(e.rec.shortId))
+			remove(seq);
+		if (const quint64 seq = byKey.value(e.key))
+			remove(seq);
+
+		byShortId.insert(e.rec.shortId, e.seq);
+		byKey.insert(e.key, e.seq);
+		byInstance.insert(e.rec.instanceName, e.seq);
+		byAction.insert(e.rec.actionType, e.seq);
+		byTime.insert({ e.rec.timestamp, e.seq }, e.seq);
+		dataBytes += e.memoryBytes();
+		entries.insert(e.seq, std::move(e));
+	}
+
+	void remove(quint64 seq)
+	{
+		const auto it = entries.find(seq);
+		if (it == entries.end())
+			return;
+		const ConnectorEntry &e = it.value();
+		byShortId.remove(e.rec.shortId);
+		byKey.remove(e.key);
+		byInstance.remove(e.rec.instanceName, seq);
+		byAction.remove(e.rec.actionType, seq);
+		byTime.remove({ e.rec.timestamp, seq });
+		dataBytes -= e.memoryBytes();
+		entries.erase(it);
+	}
+
+	// Calls `fn` with each entry matching `q` in the requested order; `fn` returns false to stop.
+	template <typename Fn>
+	void select(const ConnectorQuery &q, Fn fn) const
+	{
+		// Use the most selective exact-match index, if any.
+		QList<quint64> candidates;
+		bool indexed = false;
+		for (const auto &[col, glob] : q.globFilters) {
+			if (!glob.isLiteral())
+				continue;
+			QList<quint64> seqs;
+			if (col == ConnectorRecord::COL_SHORTID) {
+				if (const quint64 seq = byShortId.value(glob.literal()))
+					seqs << seq;
+			}
+			else if (col == ConnectorRecord::COL_NAME)
+				seqs = byInstance.values(glob.literal());
+			else if (col == ConnectorRecord::COL_ACTTYPE)
+				seqs = byAction.values(glob.literal());
+			else
+				continue;
+			if (!indexed || seqs.size() < candidates.size())
+				candidates = std::move(seqs);
+			indexed = true;
+			if (candidates.isEmpty())
+				return;
+		}
+
+		// Without a custom order, a full scan in timestamp order needs no sorting and can stop early.
+		if (!indexed && q.order.empty()) {
+			for (auto it = byTime.cend(), en = byTime.cbegin(); it != en; ) {
+				const ConnectorEntry &e = entries.find((--it).value()).value();
+				if (q.matches(e) && !fn(e))
+					return;
+			}
+			return;
+		}
+
+		std::vector<const ConnectorEntry *> results;
+		if (indexed) {
+			results.reserve(candidates.size());
+			for (const quint64 seq : std::as_const(candidates)) {
+				const ConnectorEntry &e = entries.find(seq).value();
+				if (q.matches(e))
+					results.push_back(&e);
+			}
+		}
+		else {
+			for (const ConnectorEntry &e : entries) {
+				if (q.matches(e))
+					results.push_back(&e);
+			}
+		}
+		std::sort(results.begin(), results.end(), [&q](const ConnectorEntry *a, const ConnectorEntry *b) { return q.lessThan(a, b); });
+		for (const ConnectorEntry *e : results) {
+			if (!fn(*e))
+				return;
+		}
+	}
+};
+
+using ConnectorSnapshotPtr = std::shared_ptr<const ConnectorSnapshot>;
+
+// The record store shared by all ConnectorData instances. Readers take a reference to the current snapshot, which only needs a lock for as long
+// as it takes to copy the pointer, and then search it for as long as they need. Writers build the next snapshot and swap it in.
+class ConnectorStore
+{
+	public:
+		ConnectorStore() : m_current(std::make_shared<const ConnectorSnapshot>()) { }
+
+		// Returns the current snapshot. If the pointer was being swapped the time spent waiting is returned in `waitNs`, otherwise it is set to 0.
+		ConnectorSnapshotPtr current(qint64 *waitNs = nullptr) const
+		{
+			qint64 waited = 0;
+			if (!m_currentMutex.tryLock()) {
+				QElapsedTimer timer;
+				timer.start();
+				m_currentMutex.lock();
+				waited = timer.nsecsElapsed();
+			}
+			ConnectorSnapshotPtr ret = m_current;
+			m_currentMutex.unlock();
+			if (waitNs)
+				*waitNs = waited;
+			return ret;
+		}
+
+		// Adds all the records in a single new snapshot, in order.
+		void insert(const QVector<ConnectorRecord> &records)
+		{
+			std::vector<ConnectorEntry> entries;
+			entries.reserve(records.size());
+			const qint64 ts = QDateTime::currentMSecsSinceEpoch();
+			for (const ConnectorRecord &cr : records) {
+				ConnectorEntry e;
+				e.otherDataJson = QJsonDocument(cr.otherData).toJson(QJsonDocument::Compact);
+				for (const QByteArray &f : { QByteArray::number((int)cr.inputType), QByteArray::number((int)cr.instanceType), cr.actionType, cr.instanceName, cr.expression, cr.file, cr.alias, e.otherDataJson })
+					e.key += QByteArray::number(f.size()) + ':' + f;
+				e.rangeMin = (float)cr.otherData.value(QLatin1String("rangeMin")).toString(QStringLiteral("0")).toDouble();
+				e.rangeMax = (float)cr.otherData.value(QLatin1String("rangeMax")).toString(QStringLiteral("0")).toDouble();
+				e.rec = cr;
+				e.rec.timestamp = ts;
+				entries.push_back(std::move(e));
+			}
+
+			QMutexLocker wlock(&m_writeMutex);
+			std::shared_ptr<ConnectorSnapshot> next = std::make_shared<ConnectorSnapshot>(*current());
+			for (ConnectorEntry &e : entries)
+				next->insert(std::move(e));
+			++next->version;
+
+			ConnectorSnapshotPtr prev;
+			m_currentMutex.lock();
+			prev = std::exchange(m_current, std::move(next));
+			m_currentMutex.unlock();
+			// `prev` is released outside the lock, and only actually deleted here if no reader still holds it.
+		}
+
+	private:
+		mutable QMutex m_currentMutex;
+		QMutex m_writeMutex;
+		ConnectorSnapshotPtr m_current;
+};
+
+Q_GLOBAL_STATIC(ConnectorStore, g_connectorStore)
+
+using ConnectorQueryPtr = std::shared_ptr<const ConnectorQuery>;
+
+// Compiled queries by their criteria. Scripts and the plugin tend to run the same few searches over and over (eg. on every slider or repeat
+// rate change), so these skip re-resolving the property names, parsing the sort order and compiling the patterns. Criteria values are only
+// ever used as match patterns, never as part of any query text.
+class ConnectorQueryCache
+{
+	public:
+		ConnectorQueryPtr get(const QMultiMap<QString, QVariant> &query)
+		{
+			const QByteArray key = ConnectorData::queryKey(query);
+			QMutexLocker lock(&m_mutex);
+			if (const ConnectorQueryPtr *q = m_cache.object(key)) {
+				++m_hits;
+				return *q;
+			}
+			++m_misses;
+			lock.unlock();
+			ConnectorQueryPtr q = std::make_shared<const ConnectorQuery>(query);
+			lock.relock();
+			m_cache.insert(key, new ConnectorQueryPtr(q));
+			return q;
+		}
+
+		QVariantMap statistics() const
+		{
+			QMutexLocker lock(&m_mutex);
+			return QVariantMap {
+				{ QStringLiteral("hits"),     m_hits },
+				{ QStringLiteral("misses"),   m_misses },
+				{ QStringLiteral("size"),     (int)m_cache.size() },
+				{ QStringLiteral("capacity"), (int)m_cache.maxCost() },
+			};
+		}
+
+	private:
+		mutable QMutex m_mutex;
+		QCache<QByteArray, ConnectorQueryPtr> m_cache { CONNECTOR_QUERY_CACHE_CAPACITY };
+		quint32 m_hits = 0;
+		quint32 m_misses = 0;
+};
+
+Q_GLOBAL_STATIC(ConnectorQueryCache, g_connectorQueryCache)
+
+void reportError(const QString &err, QString *error)
+{
+	if (error)
+		*error = err;
+	else
+		qCWarning(lcPlugin) << err;
+}
+
+}  // namespace
+
+
+ConnectorData::ConnectorData(const QString &connName, QObject *p) :
+  QObject(p),
+  m_primary(connName == CONNECTOR_DATA_PRIMARY_DB_CONN_NAME)
+{
+	setObjectName(connName);
+}
+
+ConnectorData *ConnectorData::instance()
+{
+	static ConnectorData cd(CONNECTOR_DATA_PRIMARY_DB_CONN_NAME);
+	return &cd;
+}
+
+QByteArray ConnectorData::queryKey(const QMultiMap<QString, QVariant> &query)
+{
+	QByteArray key;
+	for (auto const &[k, v] : query.asKeyValueRange())
+		key += k.toUtf8() + '\x1f' + QByteArray::number(v.typeId()) + '\x1f' + v.toString().toUtf8() + '\x1e';
+	return key;
+}
+
+void ConnectorData::insert(const QVector<ConnectorRecord> &records)
+{
+	if (!m_primary) {
+		qCWarning(lcPlugin) << "Connector records can only be inserted by the primary connector data instance, not" << objectName();
+		return;
+	}
+	if (records.isEmpty())
+		return;
+
+	g_connectorStore->insert(records);
+
+	QByteArrayList instanceNames, shortIds;
+	instanceNames.reserve(records.size());
+	shortIds.reserve(records.size());
+	for (const ConnectorRecord &cr : records) {
+		// A burst can report the same connector more than once.
+		bool dupe = false;
+		for (qsizetype i = shortIds.indexOf(cr.shortId); i > -1 && !dupe; i = shortIds.indexOf(cr.shortId, i + 1))
+			dupe = instanceNames.at(i) == cr.instanceName;
+		if (dupe)
+			continue;
+		instanceNames << cr.instanceName;
+		shortIds << cr.shortId;
+	}
+	Q_EMIT connectorsUpdated(instanceNames, shortIds);
+}
+
+QStringList ConnectorData::getShortIds(const QMultiMap<QString, QVariant> &query, QString *error) const
+{
+	const ConnectorQueryPtr q = g_connectorQueryCache->get(query);
+	if (!q->error.isEmpty()) {
+		reportError(q->error, error);
+		return QStringList();
+	}
+	QStringList ret;
+	qint64 waitNs;
+	const ConnectorSnapshotPtr snap = g_connectorStore->current(&waitNs);
+	recordQuery(waitNs);
+	snap->select(*q, [&](const ConnectorEntry &e) { ret << QString::fromUtf8(e.rec.shortId); return true; });
+	return ret;
+}
+
+ConnectorRecord ConnectorData::getByShortId(const QByteArray &shortId, QString *error) const
+{
+	// Short IDs are unique so this isn't worth caching.
+	QMultiMap<QString, QVariant> query;
+	query.insert(ConnectorRecord::columnNames().at(ConnectorRecord::COL_SHORTID), shortId);
+	const ConnectorQuery q(query);
+	if (!q.error.isEmpty()) {
+		reportError(q.error, error);
+		return ConnectorRecord();
+	}
+	ConnectorRecord ret;
+	qint64 waitNs;
+	const ConnectorSnapshotPtr snap = g_connectorStore->current(&waitNs);
+	recordQuery(waitNs);
+	snap->select(q, [&](const ConnectorEntry &e) { ret = e.rec; return false; });
+	return ret;
+}
+
+QVector<ConnectorRecord> ConnectorData::records(const QMultiMap<QString, QVariant> &query, QString *error) const
+{
+	const ConnectorQueryPtr q = g_connectorQueryCache->get(query);
+	if (!q->error.isEmpty()) {
+		reportError(q->error, error);
+		return QVector<ConnectorRecord>();
+	}
+	QVector<ConnectorRecord> ret;
+	qint64 waitNs;
+	const ConnectorSnapshotPtr snap = g_connectorStore->current(&waitNs);
+	recordQuery(waitNs);
+	snap->select(*q, [&](const ConnectorEntry &e) { ret << e.rec; return true; });
+	return ret;
+}
+
+QVector<ConnectorFeedback> ConnectorData::feedbackTargets(const QMultiMap<QString, QVariant> &query, QString *error) const
+{
+	const ConnectorQueryPtr q = g_connectorQueryCache->get(query);
+	if (!q->error.isEmpty()) {
+		reportError(q->error, error);
+		return QVector<ConnectorFeedback>();
+	}
+	QVector<ConnectorFeedback> ret;
+	qint64 waitNs;
+	const ConnectorSnapshotPtr snap = g_connectorStore->current(&waitNs);
+	recordQuery(waitNs);
+	snap->select(*q, [&](const ConnectorEntry &e) { ret.append({ e.rec.shortId, e.rangeMin, e.rangeMax }); return true; });
+	return ret;
+}
+
+void ConnectorData::recordQuery(qint64 lockWaitNs) const
+{
+	++m_queries;
+	if (!lockWaitNs)
+		return;
+	++m_lockWaits;
+	m_lockWaitTotalNs += lockWaitNs;
+	qint64 prev = m_lockWaitMaxNs;
+	while (lockWaitNs > prev && !m_lockWaitMaxNs.compare_exchange_weak(prev, lockWaitNs))
+		;
+}
+
+QVariantMap ConnectorData::statistics() const
+{
+	const ConnectorSnapshotPtr snap = g_connectorStore->current();
+	const quint32 waits = m_lockWaits;
+	return QVariantMap {
+		{ QStringLiteral("records"),           (qint64)snap->entries.size() },
+		{ QStringLiteral("dataBytes"),         snap->dataBytes },
+		{ QStringLiteral("version"),           snap->version },
+		{ QStringLiteral("queries"),           (quint32)m_queries },
+		{ QStringLiteral("lockWaits"),         waits },
+		{ QStringLiteral("maxLockWaitMs"),     m_lockWaitMaxNs / 1.0e6 },
+		{ QStringLiteral("averageLockWaitMs"), waits ? m_lockWaitTotalNs / 1.0e6 / waits : 0.0 },
+		{ QStringLiteral("queryCache"),        g_connectorQueryCache->statistics() },
+	};
+}
+
+#include "moc_ConnectorData.cpp"
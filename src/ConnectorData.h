@@ -21,12 +21,14 @@ to any 3rd-party components used within.
 #pragma once
 
 #include <QObject>
-#include <QJsonDocument>
+#include <QByteArrayList>
 #include <QJsonObject>
 #include <QMetaEnum>
-#include <QSqlDatabase>
-#include <QSqlError>
-#include <QSqlQuery>
+#include <QMultiMap>
+#include <QVariant>
+#include <QVariantMap>
+
+#include <atomic>
 
 #include "common.h"
 #include "DSE_NS.h"
@@ -159,7 +161,7 @@ class ConnectorRecord
 
 		DseNS::ScriptInputType inputType = DseNS::ScriptInputType::UnknownInputType;
 		DseNS::EngineInstanceType instanceType = DseNS::EngineInstanceType::UnknownInstanceType;
-		qint64 timestamp;
+		qint64 timestamp = 0;
 		QByteArray actionType;
 		QByteArray instanceName;
 		QByteArray connectorId;
@@ -172,36 +174,15 @@ class ConnectorRecord
 		QString inputTypeStr() const { return DseNS::inputTypeMeta().key((int)inputType); }
 		QString instanceTypeStr() const { return DseNS::instanceTypeMeta().key((int)instanceType); }
 		bool isNull() const { return !timestamp; }
+};
 
-		explicit ConnectorRecord(QSqlQuery *qry)
-		{
-			instanceName  = qry->value(COL_NAME).toByteArray();
-			actionType    = qry->value(COL_ACTTYPE).toByteArray();
-			expression    = qry->value(COL_EXPR).toByteArray();
-			file          = qry->value(COL_FILE).toByteArray();
-			alias         = qry->value(COL_ALIAS).toByteArray();
-			connectorId   = qry->value(COL_CONNID).toByteArray();
-			shortId       = qry->value(COL_SHORTID).toByteArray();
-			timestamp     = qry->value(COL_TS).toLongLong();
-			inputType    = DseNS::ScriptInputType(qry->value(COL_INPTYPE).toUInt());
-			instanceType = DseNS::EngineInstanceType(qry->value(COL_INSTYPE).toUInt());
-			otherData     = QJsonDocument::fromJson(qry->value(COL_OTHER).toByteArray()).object();
-		}
 
-		void bindAll(QSqlQuery *qry) const
-		{
-			qry->bindValue(COL_NAME,  qPrintable(instanceName));
-			qry->bindValue(COL_ACTTYPE,  qPrintable(actionType));
-			qry->bindValue(COL_EXPR,  qPrintable(expression));
-			qry->bindValue(COL_FILE, qPrintable(file));
-			qry->bindValue(COL_ALIAS, qPrintable(alias));
-			qry->bindValue(COL_CONNID, qPrintable(connectorId));
-			qry->bindValue(COL_SHORTID, qPrintable(shortId));
-			qry->bindValue(COL_INPTYPE,  uint(inputType));
-			qry->bindValue(COL_INSTYPE, uint(instanceType));
-			qry->bindValue(COL_OTHER, QJsonDocument(otherData).toJson(QJsonDocument::Compact));
-			qry->bindValue(COL_TS, QDateTime::currentMSecsSinceEpoch());
-		}
+// Slider value range of a stored connector, from its "rangeMin" and "rangeMax" otherData values (0 when missing).
+struct ConnectorFeedback
+{
+	QByteArray shortId;
+	float rangeMin;
+	float rangeMax;
 };
 
 
@@ -209,230 +190,54 @@ class ConnectorRecord
 // ConnectorData
 // ---------------------------------
 
+// Stores the connector records reported by Touch Portal. All instances share one in-memory store which is indexed by shortId, instanceName,
+// actionType and timestamp; the primary instance() is the only one which inserts records and emits connectorsUpdated(). Each insert publishes
+// a new read-only snapshot of the store and lookups search the latest one, so they are thread-safe and never wait for each other or for inserts.
+// Other instances are just lightweight views (eg. one per engine) which keep their own statistics.
 class ConnectorData : public QObject
 {
 		Q_OBJECT
 	public:
-		explicit ConnectorData(const QString &connName, QObject *p = nullptr)
-		  : QObject(p), m_primary(connName == CONNECTOR_DATA_PRIMARY_DB_CONN_NAME)
-		{
-			if (QSqlDatabase::contains(connName)) {
-				m_db = QSqlDatabase::database(connName, true);
-				qCDebug(lcPlugin) << "Existing DB" << m_db.connectionName() << m_db.databaseName();
-			}
-			else
-				setupDatabase(connName);
-		}
+		explicit ConnectorData(const QString &connName, QObject *p = nullptr);
 
-		~ConnectorData()
-		{
-			const QString cname(m_db.connectionName());
-			m_db.close();
-			m_db = QSqlDatabase();
-			QSqlDatabase::removeDatabase(cname);
-		}
+		static ConnectorData *instance();
 
-		static ConnectorData *instance() {
-			static ConnectorData cd(CONNECTOR_DATA_PRIMARY_DB_CONN_NAME);
-			return &cd;
-		}
+		bool isPrimary() const { return m_primary; }
 
-		void insert(const ConnectorRecord &cr)
-		{
-			if (!m_db.isOpen())
-				return;
-
-			const auto &cnames = ConnectorRecord::columnNames();
-			auto placeholders = QStringLiteral("?,").repeated(ConnectorRecord::columnNames().size());
-			placeholders.chop(1);
-
-			QSqlQuery qry(m_db);
-			qry.prepare(
-			  QStringLiteral("REPLACE INTO ConnectorData (%1) VALUES (%2)").arg(cnames.join(','), placeholders)
-			);
-			cr.bindAll(&qry);
-			if (!qry.exec())
-				qCCritical(lcPlugin) << "Failed to insert record into" << m_db.connectionName() << m_db.databaseName() << ':' << qry.lastError().text() << '\n' << qry.executedQuery() << '\n' << qry.boundValues();
-			else
-				Q_EMIT connectorsUpdated(cr.instanceName, cr.shortId);
-		}
+		// Adds records, each one replacing any existing record with the same shortId or the same connector definition
+		// (input and instance types, actionType, instanceName, expression, file, alias and otherData).
+		// The whole batch is stored at once and reported with a single connectorsUpdated() signal.
+		void insert(const QVector<ConnectorRecord> &records);
+		void insert(const ConnectorRecord &cr) { insert(QVector<ConnectorRecord>{ cr }); }
 
-		QStringList getShortIds(const QMultiMap<QString, QVariant> &query, QString *error = nullptr)
-		{
-			if (!m_db.isOpen())
-				return QStringList();
-
-			const QString sql = buildQuery(query, QStringLiteral("shortId"));
-
-			QSqlQuery qry(sql, m_db);
-			qry.setForwardOnly(true);
-			if (!qry.exec())  {
-				const QString err = tr("SQL query failed with error: %1").arg(qry.lastError().text());
-				if (error)
-					*error = err;
-				else
-					qCWarning(lcPlugin) << err;
-				return QStringList();
-			}
-			QStringList ret;
-			while (qry.next())
-				ret << qry.value(0).toString();
-			//qCDebug(lcPlugin) << ret;
-			return ret;
-		}
+		// Query keys are ConnectorRecord property names. Enum properties are matched by value or key name, all others by a case-sensitive GLOB pattern,
+		// and multiple criteria must all match. Results are newest first unless the special "orderBy" key specifies another sort order.
+		QStringList getShortIds(const QMultiMap<QString, QVariant> &query, QString *error = nullptr) const;
+		// The shortId may be a GLOB pattern, in which case the newest matching record is returned.
+		ConnectorRecord getByShortId(const QByteArray &shortId, QString *error = nullptr) const;
+		QVector<ConnectorRecord> records(const QMultiMap<QString, QVariant> &query, QString *error = nullptr) const;
+		// Same query as records() but only returns the shortIds with their numeric value ranges, which are parsed once when the records are stored.
+		QVector<ConnectorFeedback> feedbackTargets(const QMultiMap<QString, QVariant> &query, QString *error = nullptr) const;
 
-		ConnectorRecord getByShortId(const QByteArray &shortId, QString *error = nullptr)
-		{
-			if (!m_db.isOpen())
-				return ConnectorRecord();
-
-			const QString sql = QStringLiteral("SELECT %1 FROM ConnectorData WHERE shortId LIKE '%2' ORDER BY timestamp DESC LIMIT 1").arg(ConnectorRecord::columnNames().join(','), shortId);
-			QSqlQuery qry(sql, m_db);
-			qry.setForwardOnly(true);
-			if (qry.exec())
-				return qry.next() ? ConnectorRecord(&qry) : ConnectorRecord();
-
-			const QString err = tr("SQL query failed with error: %1").arg(qry.lastError().text());
-			if (error)
-				*error = err;
-			else
-				qCWarning(lcPlugin) << err;
-			return ConnectorRecord();
-		}
+		// A key which uniquely identifies the criteria of `query`, eg. for caching results.
+		static QByteArray queryKey(const QMultiMap<QString, QVariant> &query);
 
-		QVector<ConnectorRecord> records(const QMultiMap<QString, QVariant> &query, QString *error = nullptr)
-		{
-			if (!m_db.isOpen())
-				return QVector<ConnectorRecord>();
-
-			const QString sql = buildQuery(query, ConnectorRecord::columnNames().join(','));
-
-			QSqlQuery qry(sql, m_db);
-			qry.setForwardOnly(true);
-			if (!qry.exec())  {
-				const QString err = tr("SQL query failed with error: %1").arg(qry.lastError().text());
-				if (error)
-					*error = err;
-				else
-					qCWarning(lcPlugin) << err;
-				return QVector<ConnectorRecord>();
-			}
-
-			QVector<ConnectorRecord> ret;
-			while (qry.next())
-				ret << ConnectorRecord(&qry);
-			return ret;
-		}
+		// Size of the store and the query cache, and this instance's query count and time spent waiting to get the current snapshot.
+		// The record count and dataBytes are for the whole shared store, not this instance; views don't hold any records of their own.
+		QVariantMap statistics() const;
 
 	Q_SIGNALS:
-		void connectorsUpdated(const QByteArray &instanceName, const QByteArray &shortId);
+		// Emitted after each insert() with the instance name and shortId of every record added or replaced; the two lists are the same length.
+		void connectorsUpdated(const QByteArrayList &instanceNames, const QByteArrayList &shortIds);
 
 	private:
+		void recordQuery(qint64 lockWaitNs) const;
 
-		QString buildQuery(const QMultiMap<QString, QVariant> &query, QStringView select) const
-		{
-			QStringList filter;
-
-			auto addEnumFltr = [&](const QString &key, const QVariant &p, const QMetaEnum &meta) {
-				if (p.canConvert<QString>()) {
-					bool ok;
-					const int e = meta.keyToValue(qPrintable(p.toString()), &ok);
-					if (ok)
-						filter << key + '=' + QString::number(e);
-				}
-			};
-			auto addStringFltr = [&](const QString &key, const QVariant &p) {
-				if (p.canConvert<QString>())
-					filter << key + " GLOB '" + p.toString() + '\'';
-			};
-			for (auto const &[k, v] : query.asKeyValueRange()) {
-				if (ConnectorRecord::enumPropertyNames().contains(k)) {
-					if (v.canConvert<int>())
-						filter << k + '=' + QString::number(v.toInt());
-					else
-						addEnumFltr(k, v, ConnectorRecord::enumProperties().value(k));
-				}
-				else {
-					addStringFltr(k, v);
-				}
-			}
-
-			const QString orderBy = query.value(QStringLiteral("orderBy"), QStringLiteral("timestamp DESC")).toString();
-
-			QString sql = QStringLiteral("SELECT %1 FROM ConnectorData").arg(select);
-			if (filter.size())
-				sql += " WHERE " + filter.join(QLatin1String(" AND "));
-			sql += " ORDER BY " + orderBy;
-
-			//qCDebug(lcPlugin) << sql;
-			return sql;
-		}
-
-		static std::atomic_bool &dbCreated()
-		{
-			static std::atomic_bool created = false;
-			return created;
-		}
-
-		void setupDatabase(const QString &name)
-		{
-			m_db = QSqlDatabase::addDatabase("QSQLITE", name);
-			m_db.setDatabaseName("file:connectors?mode=memory&cache=shared");
-			QString connOpts("QSQLITE_ENABLE_SHARED_CACHE;QSQLITE_OPEN_URI");  // ;QSQLITE_ENABLE_REGEXP
-			if (!m_primary)
-				connOpts += ";QSQLITE_OPEN_READONLY";
-			m_db.setConnectOptions(connOpts);
-			if (!m_db.open()) {
-				m_db.setConnectOptions();
-				qCCritical(lcPlugin) << "Unable to establish database connection for" << name << "with error:" << m_db.lastError();
-				return;
-			}
-
-			qCDebug(lcPlugin) << "Opened DB" << m_db.connectionName() << m_db.databaseName() << "Created?" << dbCreated();
-			if (dbCreated())
-				return;
-			dbCreated() = true;
-
-			m_db.transaction();
-			QSqlQuery q(m_db);
-			auto execQry = [&](const QString &s) -> bool {
-				if (q.exec(s))
-					return true;
-				qCDebug(lcPlugin) << "Query error for" << m_db.connectionName() << m_db.databaseName() << m_db.connectionNames() << '\n' << q.lastError() << '\n' << q.executedQuery() << '\n' << s;
-				return false;
-			};
-
-			const QString sql(QStringLiteral(
-				"CREATE TABLE ConnectorData ("
-			  "  actionType   varchar(25)  NOT NULL,"
-				"  instanceName varchar(100) NOT NULL DEFAULT '',"
-				"  expression   TEXT         NOT NULL DEFAULT '',"
-				"  file         varchar(255) NOT NULL DEFAULT '',"
-				"  alias        varchar(30)  NOT NULL DEFAULT '',"
-				"  connectorId  varchar(200) NOT NULL DEFAULT '',"
-				"  shortId      varchar(20)  NOT NULL UNIQUE,"
-			  "  otherData    TEXT         NOT NULL DEFAULT '{}',"
-			  "  inputType    INTEGER      NOT NULL DEFAULT 0,"
-			  "  instanceType INTEGER      NOT NULL DEFAULT 0,"
-				"  timestamp    INTEGER      NOT NULL,"
-				"  PRIMARY KEY(inputType, instanceType, actionType, instanceName, expression, file, alias, otherData)"
-				") WITHOUT ROWID;"
-			));
-			if (!execQry(sql)) {
-				m_db.rollback();
-				qCCritical(lcPlugin) << "Failed to created database definitions for" << m_db.connectionName() << m_db.databaseName();
-				return;
-			}
-			qCDebug(lcPlugin) << "Created database definitions for" << m_db.connectionName() << m_db.databaseName();
-
-			for (const auto &prop : ConnectorRecord::columnNames())
-				execQry(QStringLiteral("CREATE INDEX IDX_%1 ON ConnectorData (%1);").arg(prop));
-
-			m_db.commit();
-		}
-
-		QSqlDatabase m_db;
 		bool m_primary = false;
+		mutable std::atomic_uint m_queries {0};
+		mutable std::atomic_uint m_lockWaits {0};
+		mutable std::atomic<qint64> m_lockWaitTotalNs {0};
+		mutable std::atomic<qint64> m_lockWaitMaxNs {0};
 };
 
 Q_DECLARE_METATYPE(ConnectorRecord)
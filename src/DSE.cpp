@@ -76,6 +76,8 @@ Q_GLOBAL_STATIC(DSE::ScriptState, g_instances)
 Q_GLOBAL_STATIC(QReadWriteLock, g_instanceMutex)
 Q_GLOBAL_STATIC(DSE::EngineState, g_engines)
 Q_GLOBAL_STATIC(QReadWriteLock, g_engineMutex)
+Q_GLOBAL_STATIC(QVariantHash, g_sharedValues)
+Q_GLOBAL_STATIC(QReadWriteLock, g_sharedValuesMutex)
 
 DSE::ScriptState *DSE::instances() { return g_instances; }
 QReadWriteLock *DSE::instances_mutex() { return g_instanceMutex; }
@@ -191,6 +193,55 @@ DSE::DSE(ScriptEngine *se, QObject *p) :
 
 QByteArray DSE::engineInstanceName() const { return se->name(); }
 
+QVariantMap DSE::engineStats() const { return se->statistics(); }
+
+void DSE::setSharedValue(const QString &key, const QJSValue &value)
+{
+	if (value.isUndefined()) {
+		removeSharedValue(key);
+		return;
+	}
+	// converting to a variant makes a deep copy which no longer refers to the originating engine
+	const QVariant var = value.toVariant();
+	QWriteLocker l(g_sharedValuesMutex);
+	g_sharedValues->insert(key, var);
+}
+
+QJSValue DSE::sharedValue(const QString &key, const QJSValue &defaultValue) const
+{
+	QReadLocker l(g_sharedValuesMutex);
+	const auto it = g_sharedValues->constFind(key);
+	if (it == g_sharedValues->cend())
+		return defaultValue;
+	const QVariant var = it.value();
+	l.unlock();
+	return se->engine()->toScriptValue(var);
+}
+
+bool DSE::removeSharedValue(const QString &key)
+{
+	QWriteLocker l(g_sharedValuesMutex);
+	return g_sharedValues->remove(key) > 0;
+}
+
+QStringList DSE::sharedValueKeys()
+{
+	QReadLocker l(g_sharedValuesMutex);
+	return g_sharedValues->keys();
+}
+
+int DSE::expressionCacheSize() const { return se->expressionCacheCapacity(); }
+
+void DSE::setExpressionCacheSize(int size) { se->setExpressionCacheCapacity(size); }
+
+int DSE::gcIdleDelay() const { return se->gcIdleDelay(); }
+
+void DSE::setGcIdleDelay(int ms) { se->setGcIdleDelay(ms); }
+
+int DSE::gcHeapBudget() const { return int(se->gcHeapBudget() / (1024 * 1024)); }
+
+void DSE::setGcHeapBudget(int mb) { se->setGcHeapBudget(qint64(mb) * 1024 * 1024); }
+
 QByteArray DSE::instanceDefault() const {
 	if (DynamicScript *ds = instance(instanceName))
 		return ds->defaultValue();
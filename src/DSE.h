@@ -139,6 +139,8 @@ namespace DSE
 		//! Returns the name of the engine instance associated with the current script instance. For the global shared engine this is always "Shared".
 		//! For private engine instances, this may or may not be the same as the script's Instance Name,
 		//! for example if a script action was set to use a specific private named engine instance instead of just "Private".
+		//! If the plugin is configured to use more than one Shared engine, the additional ones are named "Shared#1", "Shared#2", and so on.
+		//! These names appear in the engine lists of the plugin's engine actions, so each one can be reset by name, but like "Shared" they can not be deleted.
 		//! Unlike \ref currentInstanceName property, this value will always be constant, even inside asyncronous methods.  \sa currentInstanceName, DynamicScript.engineName
 		//! \since v1.2
 		Q_PROPERTY(QString engineInstanceName READ engineInstanceName CONSTANT)
@@ -150,6 +152,21 @@ namespace DSE
 		Q_PROPERTY(QString currentInstanceName READ currentInstanceName CONSTANT)
 		//! Alias for \ref engineInstanceType. \sa DynamicScript.engineType  \since v1.2
 		Q_PROPERTY(DseNS::EngineInstanceType currentInstanceType READ instanceType CONSTANT)
+		//! The maximum number of compiled expressions this engine instance keeps cached for re-use. Expressions which are evaluated repeatedly,
+		//! for example from button presses or connector changes, are compiled once and then only called while they remain in the cache.
+		//! The least recently used expressions are discarded once the limit is reached. Default is 200, and setting it to `0` disables caching.
+		//! The cache is cleared whenever the engine is reset. \sa engineStats()
+		//! \since v1.2
+		Q_PROPERTY(int expressionCacheSize READ expressionCacheSize WRITE setExpressionCacheSize)
+		//! The time, in milliseconds, this engine instance must be idle after running a script before its memory is cleaned up ("garbage collected").
+		//! Collecting while idle keeps memory usage in check without pausing in the middle of a script evaluation. Default is 3000 ms, and `0` disables idle-time collection.
+		//! \sa gcHeapBudget, engineStats()
+		//! \since v1.2
+		Q_PROPERTY(int gcIdleDelay READ gcIdleDelay WRITE setGcIdleDelay)
+		//! The size, in megabytes, which this engine instance's memory heap may grow to before it is garbage collected even if the engine is not idle.
+		//! Collection still happens between evaluations, never during one. Default is 32 MB, and `0` disables this limit. \sa gcIdleDelay, engineStats()
+		//! \since v1.2
+		Q_PROPERTY(int gcHeapBudget READ gcHeapBudget WRITE setGcHeapBudget)
 
 		//! The scope of the current script's engine, either "Shared" or "Private".
 		//! \deprecated{v1.2}
@@ -213,6 +230,22 @@ namespace DSE
 		Q_PROPERTY(DseNS::RepeatProperty RepeatRateProperty  READ RepeatProperty_RepeatRateProperty  CONSTANT)
 		Q_PROPERTY(DseNS::RepeatProperty RepeatDelayProperty READ RepeatProperty_RepeatDelayProperty CONSTANT)
 		Q_PROPERTY(DseNS::RepeatProperty AllRepeatProperties READ RepeatProperty_AllRepeatProperties CONSTANT)
+
+		static DseNS::EvaluationQueuePolicy EvaluationQueuePolicy_DefaultQueuePolicy() { return DseNS::DefaultQueuePolicy; }
+		static DseNS::EvaluationQueuePolicy EvaluationQueuePolicy_QueueAll()           { return DseNS::QueueAll; }
+		static DseNS::EvaluationQueuePolicy EvaluationQueuePolicy_LatestWins()         { return DseNS::LatestWins; }
+		static DseNS::EvaluationQueuePolicy EvaluationQueuePolicy_DropNew()            { return DseNS::DropNew; }
+		Q_PROPERTY(DseNS::EvaluationQueuePolicy DefaultQueuePolicy READ EvaluationQueuePolicy_DefaultQueuePolicy CONSTANT)
+		Q_PROPERTY(DseNS::EvaluationQueuePolicy QueueAll           READ EvaluationQueuePolicy_QueueAll           CONSTANT)
+		Q_PROPERTY(DseNS::EvaluationQueuePolicy LatestWins         READ EvaluationQueuePolicy_LatestWins         CONSTANT)
+		Q_PROPERTY(DseNS::EvaluationQueuePolicy DropNew            READ EvaluationQueuePolicy_DropNew            CONSTANT)
+
+		static DseNS::HiddenPageBehavior HiddenPageBehavior_RunWhenHidden()      { return DseNS::RunWhenHidden; }
+		static DseNS::HiddenPageBehavior HiddenPageBehavior_ThrottleWhenHidden() { return DseNS::ThrottleWhenHidden; }
+		static DseNS::HiddenPageBehavior HiddenPageBehavior_PauseWhenHidden()    { return DseNS::PauseWhenHidden; }
+		Q_PROPERTY(DseNS::HiddenPageBehavior RunWhenHidden      READ HiddenPageBehavior_RunWhenHidden      CONSTANT)
+		Q_PROPERTY(DseNS::HiddenPageBehavior ThrottleWhenHidden READ HiddenPageBehavior_ThrottleWhenHidden CONSTANT)
+		Q_PROPERTY(DseNS::HiddenPageBehavior PauseWhenHidden    READ HiddenPageBehavior_PauseWhenHidden    CONSTANT)
 /*
 		static DseNS::AdjustmentType AdjustmentType_SetAbsolute() { return DseNS::SetAbsolute; }
 		static DseNS::AdjustmentType AdjustmentType_SetRelative() { return DseNS::SetRelative; }
@@ -290,10 +323,79 @@ namespace DSE
 		//! and use the saved instace inside them. Or use the `instance(String name)` overload with a static string value for the instance name.
 		//! \since v1.2
 		Q_INVOKABLE DynamicScript *currentInstance() const { return instance(instanceName); }
+		//! \fn Object engineStats()
+		//! \memberof DSE
+		//! Returns an object with performance statistics of the engine instance which the current script is running in, grouped by category.
+		//! Currently available:
+		//! - `engine`: `{ initTimeMs, heapBytesBeforeLibrary, heapBytesAfterInit, heapBytes, libraryModules }` - Time it took to (re)initialize the engine,
+		//!   JavaScript heap size before loading the built-in library, after initialization, and currently. `libraryModules` lists the built-in library modules
+		//!   which have been loaded on demand since then (eg. `sprintf` or `color`) as `{ "<name>": { loadTimeMs, heapDeltaBytes } }`.
+		//!   Also `thread`, the name of the thread the engine runs in, and `sharedThread` which is `true` if it runs in a worker thread shared with other Private engines.
+		//!   For Shared engines, `shardIndex` and `shardCount` tell which of the configured number of Shared engines this is.
+		//! - `watchdog`: `{ timeLimitMs, timeouts, maxDurationMs, lastDurationMs }` - The evaluation time limit from the plugin's settings, number of evaluations in
+		//!   this engine which were interrupted for exceeding it, and the longest and most recent evaluation times.
+		//! - `gc`: `{ idleDelayMs, heapBudgetBytes, heapBytes, heapBytesAfterGc, collections, lastPauseMs, maxPauseMs, totalPauseMs }` - Scheduled garbage collection
+		//!   settings, the heap size as of the last evaluation and last collection, and the number and duration of collections run by the scheduler.
+		//! - `expressionCache`: `{ hits, misses, uncompiled, size, capacity }` - Compiled expression cache lookups, evaluations which could not use a compiled
+		//!   expression (eg. multiple statements), and the current and maximum number of cached expressions.
+		//! - `scriptFiles`: `{ "<file path>": { hits, reloads, evalTimeMs }, ... }` - For each script file loaded with a "Load Script" action in this engine,
+		//!   the number of evaluations which used the cached file contents, how many times it was re-read after changing, and total time spent evaluating its body
+		//!   (which includes compiling it, and running any top-level code).
+		//! - `enginePool`: `{ size, available, hits, misses, lastLatencyMs, maxLatencyMs, averageLatencyMs }` - Plugin-wide pool of pre-initialized Private engines:
+		//!   configured and currently ready spare engines, how many new engines were taken from the pool vs. created on demand, and how long it took to get them.
+		//!   Also `threadPoolSize`, the configured number of worker threads for Private engines, and `threadEngines`, the number of engines running in each of them.
+		//! - `repeats`: `{ scheduled, fired, skipped, pending, peakPending, lastJitterMs, maxJitterMs, averageJitterMs }` - Held action repeats of script instances
+		//!   in this engine: how many were scheduled, run, and skipped for being late (see `DynamicScript.repeatCatchUp`), how many are (or were at most) waiting,
+		//!   and how late the repeats ran compared to their scheduled time.
+		//! - `lanes`: `{ input, timers, background }` - Work waiting to run in the engine's thread is handled by priority: evaluations requested by Touch Portal
+		//!   actions and connectors first, then script timers, then background tasks like garbage collection. Each lane reports
+		//!   `{ events, lastWaitMs, maxWaitMs, averageWaitMs }`, how long the work waited to start (for timers, how long after they were due),
+		//!   and `input` also has `pending`, the number of requests waiting right now.
+		//! - `connectors`: `{ records, dataBytes, version, queries, lockWaits, maxLockWaitMs, averageLockWaitMs, queryCache }` - The plugin-wide store of
+		//!   Touch Portal connector records: number of records, their approximate size in memory, and how many times it has been updated. These three values are
+		//!   for the whole store and are the same in every engine; records are not held separately per engine, so `dataBytes` is not a per-engine memory cost.
+		//!   Searches from this engine (eg. `TP.getConnectorRecords()`) each use the latest read-only copy of the store; `queries` counts them and the `lockWait` values
+		//!   report how often and how long they had to wait while an update was being published. `queryCache` is `{ hits, misses, size, capacity }` of the plugin-wide
+		//!   cache of compiled searches.
+		//!
+		//! Counters are cumulative for the lifetime of the plugin and are not affected by engine resets. \sa expressionCacheSize
+		//! \since v1.2
+		Q_INVOKABLE QVariantMap engineStats() const;
+
+		//! \fn void setSharedValue(String key, any value)
+		//! \memberof DSE
+		//! Stores a copy of `value` under `key` in a plugin-wide store which all engine instances, Shared and Private, can read from and write to.
+		//! This is the way to share data between scripts running in different engines, since they do not share any global variables.
+		//! Only plain data can be stored: numbers, strings, booleans, dates, and arrays or objects containing those. Setting a value of `undefined` removes the key.
+		//! The store is kept in memory only, and is cleared when the plugin exits. \sa sharedValue(), removeSharedValue(), sharedValueKeys()
+		//! \since v1.2
+		Q_INVOKABLE static void setSharedValue(const QString &key, const QJSValue &value);
+		//! \fn any sharedValue(String key, any defaultValue = undefined)
+		//! \memberof DSE
+		//! Returns a copy of the value stored under `key` with \ref setSharedValue(), or `defaultValue` if there is no such key.
+		//! \since v1.2
+		Q_INVOKABLE QJSValue sharedValue(const QString &key, const QJSValue &defaultValue = QJSValue()) const;
+		//! \fn bool removeSharedValue(String key)
+		//! \memberof DSE
+		//! Removes `key` from the plugin-wide store and returns `true`, or returns `false` if there was no such key. \sa setSharedValue()
+		//! \since v1.2
+		Q_INVOKABLE static bool removeSharedValue(const QString &key);
+		//! \fn Array<String> sharedValueKeys()
+		//! \memberof DSE
+		//! Returns the keys of all values in the plugin-wide store. \sa setSharedValue()
+		//! \since v1.2
+		Q_INVOKABLE static QStringList sharedValueKeys();
+
 		DseNS::EngineInstanceType instanceType() const { return privateInstance ? DseNS::PrivateInstance : DseNS::SharedInstance; };
 		QByteArray currentInstanceName() const { return instanceName; }
 
 		QByteArray engineInstanceName() const;
+		int expressionCacheSize() const;
+		void setExpressionCacheSize(int size);
+		int gcIdleDelay() const;
+		void setGcIdleDelay(int ms);
+		int gcHeapBudget() const;
+		void setGcHeapBudget(int mb);
 
 		static inline QString stateParentCategory() { return QStringLiteral(PLUGIN_DYNAMIC_STATES_PARENT); }
 		static inline QString tpDataPath() { return QString::fromUtf8(Utils::tpDataPath()); }
@@ -86,6 +86,25 @@ enum RepeatProperty : quint8 {
 };
 Q_ENUM_NS(RepeatProperty)
 
+//! How a script instance handles new evaluation requests, eg. from Touch Portal actions or connectors, which arrive while previous ones are still waiting to run.
+//! \sa DynamicScript.queuePolicy
+enum EvaluationQueuePolicy : quint8 {
+	DefaultQueuePolicy,  //!< Connector (slider) changes are handled as with `LatestWins`, and all other requests as with `QueueAll`.
+	QueueAll,            //!< Every request is evaluated, in order, as long as there are fewer than `DynamicScript.maxQueueDepth` waiting; otherwise the new request is dropped.
+	LatestWins,          //!< Only the newest waiting request is evaluated; it replaces any other request still waiting to run.
+	DropNew,             //!< New requests are dropped while another one is waiting or being evaluated.
+};
+Q_ENUM_NS(EvaluationQueuePolicy)
+
+//! What happens to a script instance's timers, started with `setTimeout()` or `setInterval()`, while none of the Touch Portal pages it is used on is showing.
+//! \sa DynamicScript.hiddenPageBehavior, DynamicScript.pages
+enum HiddenPageBehavior : quint8 {
+	RunWhenHidden,       //!< Timers run as usual regardless of which page is showing. This is the default.
+	ThrottleWhenHidden,  //!< Repeating timers run at most once per second.
+	PauseWhenHidden,     //!< Timers are paused; any which came due in the mean time run once as soon as one of the instance's pages is showing again.
+};
+Q_ENUM_NS(HiddenPageBehavior)
+
 // Not public API for now.
 // ! How to "adjust" or set a value, eg. in an absolute or relative fashion.
 enum AdjustmentType : quint8 {
@@ -107,6 +126,8 @@ Q_DECLARE_METATYPE(DseNS::ScriptInputType)
 Q_DECLARE_METATYPE(DseNS::SavedDefaultType)
 Q_DECLARE_METATYPE(DseNS::RepeatProperty)
 Q_DECLARE_METATYPE(DseNS::AdjustmentType)
+Q_DECLARE_METATYPE(DseNS::EvaluationQueuePolicy)
+Q_DECLARE_METATYPE(DseNS::HiddenPageBehavior)
 Q_DECLARE_METATYPE(DseNS::ActivationBehavior)
 Q_DECLARE_METATYPE(DseNS::ActivationBehaviors)
 Q_DECLARE_OPERATORS_FOR_FLAGS(DseNS::ActivationBehaviors)
@@ -22,13 +22,40 @@ to any 3rd-party components used within.
 
 #include "common.h"
 #include "Plugin.h"
+#include "RepeatScheduler.h"
 #include "ScriptEngine.h"
 #include "utils.h"
 
+#include <QLocale>
+#include <cmath>
+
 using namespace DseNS;
 
-constexpr static uint32_t SAVED_PROPERTIES_VERSION = 3;
+constexpr static uint32_t SAVED_PROPERTIES_VERSION = 5;
 constexpr static int MUTEX_LOCK_TIMEOUT_MS = 250;
+// Maximum number of late repeats which are run back-to-back with repeatCatchUp enabled, beyond that they're skipped.
+constexpr static qint64 REPEAT_MAX_CATCHUP = 3;
+
+// Converts an evaluation result to the UTF-8 string sent as a State value. Integers, booleans, and numbers which JS would print in fixed notation are
+// formatted directly, without the generic QJSValue::toString() conversion; the output is the same as JS `String(value)`.
+static QByteArray resultToUtf8(const QJSValue &res)
+{
+	if (res.isString())
+		return res.toString().toUtf8();
+	if (res.isBool())
+		return res.toBool() ? QByteArrayLiteral("true") : QByteArrayLiteral("false");
+	if (res.isNumber()) {
+		const double d = res.toNumber();
+		const double absd = qAbs(d);
+		// integers which can be represented exactly
+		if (absd < 9007199254740992.0 && d == std::floor(d))
+			return QByteArray::number(qint64(d));
+		// JS uses the shortest round-trip representation, in fixed notation within this range
+		if (absd >= 1e-6 && absd < 1e21)
+			return QByteArray::number(d, 'f', QLocale::FloatingPointShortest);
+	}
+	return res.toString().toUtf8();
+}
 
 DynamicScript::DynamicScript(const QByteArray &name, QObject *p) :
   QObject(p),
@@ -42,8 +69,11 @@ DynamicScript::DynamicScript(const QByteArray &name, QObject *p) :
 
 DynamicScript::~DynamicScript() {
 	//moveToMainThread();
+	// Waits for a repeat which may be running in the engine thread right now. Plugin calls stopRepeating() first when it deletes
+	// instances while holding the instances lock, so this doesn't block then.
+	if (m_engine)
+		m_engine->repeatScheduler()->cancel(this, true);
 	QWriteLocker lock(&m_mutex);
-	setupRepeatTimer(false);
 	//qCDebug(lcPlugin) << name << "Destroyed";
 }
 
@@ -56,32 +86,32 @@ DynamicScript::~DynamicScript() {
 //	});
 //}
 
-bool DynamicScript::setExpressionProperties(const QString &expr)
+bool DynamicScript::setExpressionProperties(const QString &expr, int connectorValue)
 {
 	QWriteLocker lock(&m_mutex);
 	m_inputType = ScriptInputType::ExpressionInput;
-	bool ok = setExpr(expr);
+	bool ok = setExpr(expr, connectorValue);
 	return !(m_state.setFlag(State::PropertyErrorState, !ok) & State::CriticalErrorState);
 }
 
-bool DynamicScript::setScriptProperties(const QString &file, const QString &expr)
+bool DynamicScript::setScriptProperties(const QString &file, const QString &expr, int connectorValue)
 {
 	QWriteLocker lock(&m_mutex);
 	m_inputType = ScriptInputType::ScriptInput;
 	bool ok = setFile(file);
 	if (ok)
-		setExpr(expr);  // expression is not required
+		setExpr(expr, connectorValue);  // expression is not required
 	return !(m_state.setFlag(State::PropertyErrorState, !ok) & State::CriticalErrorState);
 }
 
-bool DynamicScript::setModuleProperties(const QString &file, const QString &alias, const QString &expr)
+bool DynamicScript::setModuleProperties(const QString &file, const QString &alias, const QString &expr, int connectorValue)
 {
 	QWriteLocker lock(&m_mutex);
 	m_inputType = ScriptInputType::ModuleInput;
 	bool ok = setFile(file);
 	if (ok) {
 		m_moduleAlias = alias.isEmpty() ? QStringLiteral("M") : alias;
-		setExpr(expr);  // expression is not required
+		setExpr(expr, connectorValue);  // expression is not required
 	}
 	return !(m_state.setFlag(State::PropertyErrorState, !ok) & State::CriticalErrorState);
 }
@@ -100,10 +130,10 @@ bool DynamicScript::setProperties(ScriptInputType type, const QString &expr, con
 	}
 }
 
-bool DynamicScript::setExpression(const QString &expr)
+bool DynamicScript::setExpression(const QString &expr, int connectorValue)
 {
 	QWriteLocker lock(&m_mutex);
-	bool ok = setExpr(expr);
+	bool ok = setExpr(expr, connectorValue);
 	return !(m_state.setFlag(State::PropertyErrorState, !ok) & State::CriticalErrorState);
 }
 
@@ -117,12 +147,14 @@ bool DynamicScript::setEngine(ScriptEngine *se)
 	if (m_engine) {
 		qCWarning(lcPlugin) << "Switching engine instances could lead to unexpected results and plugin instability.";
 		m_engine->clearInstanceData(this);
+		m_engine->repeatScheduler()->cancel(this);
 		disconnect(m_engine, nullptr, this, nullptr);
 		serializeStoredData();
 	}
 	m_engine = se;
 
 	if (se) {
+		// Private engines may share a pool worker thread, in which case we could already be living in the right one.
 		if (this->thread() != se->thread()) {
 			if (this->thread() == QThread::currentThread())
 				moveToThread(se->thread());
@@ -181,6 +213,11 @@ void DynamicScript::setPersistence(PersistenceType newPersist)
 		disconnect(this, &DynamicScript::finished, Plugin::instance, &Plugin::onDsFinished);
 }
 
+QString DynamicScript::expression() const
+{
+	return ScriptEngine::substituteConnectorValue(m_expr, m_connectorValue);
+}
+
 QJSValue &DynamicScript::dataStorage()
 {
 	if (!m_storedData.isObject()) {
@@ -196,7 +233,7 @@ QByteArray DynamicScript::serialize() const
 {
 	QByteArray ba;
 	QDataStream ds(&ba, QIODevice::WriteOnly);
-	ds << SAVED_PROPERTIES_VERSION << int(m_engine ? m_engine->instanceType() : m_scope) << (int)m_inputType << m_expr << m_file << m_moduleAlias
+	ds << SAVED_PROPERTIES_VERSION << int(m_engine ? m_engine->instanceType() : m_scope) << (int)m_inputType << expression() << m_file << m_moduleAlias
 	   << m_defaultValue << (int)m_defaultType << m_createState
 	   << m_repeatDelay << m_repeatRate << (m_engine ? m_engine->name() : m_engineName) << tpStateCategory << tpStateName
 	   << (int)m_persist << (int)m_activation;
@@ -209,6 +246,8 @@ QByteArray DynamicScript::serialize() const
 	else {
 		ds << m_storedDataVar;
 	}
+	ds << (int)m_queuePolicy << (int)m_maxQueueDepth;
+	ds << pages() << (bool)m_learnPages << (int)m_hiddenPageBehavior;
 	return ba;
 }
 
@@ -245,6 +284,21 @@ bool DynamicScript::deserialize(const QByteArray &data)
 	else if (m_scope == EngineInstanceType::PrivateInstance && m_engineName.isEmpty()) {
 		m_engineName = name;
 	}
+	if (version > 3) {
+		int queuePolicy, maxQueueDepth;
+		ds >> queuePolicy >> maxQueueDepth;
+		setQueuePolicy((EvaluationQueuePolicy)queuePolicy);
+		setMaxQueueDepth(maxQueueDepth);
+	}
+	if (version > 4) {
+		QStringList pages;
+		bool learnPages;
+		int hiddenBehavior;
+		ds >> pages >> learnPages >> hiddenBehavior;
+		m_pages = pages;
+		m_learnPages = learnPages;
+		m_hiddenPageBehavior = (HiddenPageBehavior)hiddenBehavior;
+	}
 
 	setPersistence((PersistenceType)persist);
 	setActivation((ActivationBehaviors)act);
@@ -261,13 +315,15 @@ bool DynamicScript::deserialize(const QByteArray &data)
 // -----------------
 // Private setters, no mutex
 
-bool DynamicScript::setExpr(const QString &expr)
+bool DynamicScript::setExpr(const QString &expr, int connectorValue)
 {
 	if (expr.isEmpty()) {
 		lastError = tr("Expression is empty.");
 		return false;
 	}
 	m_expr = expr; // QString(expr).replace("\\", "\\\\");
+	// The expression is kept with the connector value placeholder intact so the engine can bind the value as a function argument.
+	m_connectorValue = connectorValue > -1 && expr.contains(QLatin1String("${connector_value}"), Qt::CaseInsensitive) ? connectorValue : -1;
 	return true;
 }
 
@@ -314,12 +370,22 @@ void DynamicScript::setPressed(bool isPressed)
 		return;
 
 	m_state.setFlag(State::PressedState, isPressed);
-	if (!isPressed)
+	if (!isPressed) {
+		if (m_engine && isRepeating())
+			m_engine->repeatScheduler()->cancel(this);
 		setRepeating(false);
+	}
 
 	Q_EMIT pressedStateChanged(isPressed);
 }
 
+void DynamicScript::stopRepeating()
+{
+	setPressed(false);
+	if (m_engine)
+		m_engine->repeatScheduler()->cancel(this, true);
+}
+
 void DynamicScript::serializeStoredData()
 {
 	if (m_engine)
@@ -331,39 +397,13 @@ void DynamicScript::serializeStoredData()
 	m_storedData = QJSValue();
 }
 
-void DynamicScript::setupRepeatTimer(bool create)
-{
-	if (create == !!m_repeatTim)
-		return;
-
-	if (create) {
-		m_repeatTim = new QTimer();
-		m_repeatTim->setSingleShot(true);
-		connect(m_repeatTim, &QTimer::timeout, this, &DynamicScript::repeatEvaluate);
-		return;
-	}
-
-	disconnect(m_repeatTim, &QTimer::timeout, this, &DynamicScript::repeatEvaluate);
-	if (m_repeatTim->thread() != QThread::currentThread()) {
-		Utils::runOnThreadSync(m_repeatTim->thread(), [=]() {
-			m_repeatTim->stop();
-			m_repeatTim->deleteLater();
-			m_repeatTim = nullptr;
-		});
-	}
-	else {
-		m_repeatTim->stop();
-		delete m_repeatTim;
-		m_repeatTim = nullptr;
-	}
-}
-
-void DynamicScript::repeatEvaluate()
+void DynamicScript::repeatEvaluate(qint64 deadlineNs)
 {
 	m_activeRepeatRate = -1;
 	if (isRepeating()) {
 		//qCDebug(lcPlugin) << "Repeating" << name << m_repeatCount << m_maxRepeatCount;
 		if (m_maxRepeatCount < 0 || m_repeatCount < m_maxRepeatCount) {
+			m_repeatDeadline = deadlineNs;
 			++m_repeatCount;
 			evaluate();
 			Q_EMIT repeatCountChanged(m_repeatCount);
@@ -371,16 +411,32 @@ void DynamicScript::repeatEvaluate()
 		}
 		setRepeating(false);
 	}
-	setupRepeatTimer(false);
 }
 
 bool DynamicScript::scheduleRepeatIfNeeded()
 {
-	if (m_activation.testFlags(ActivationBehavior::RepeatOnHold) && (m_maxRepeatCount < 0 || m_repeatCount < m_maxRepeatCount)) {
-		const int delay = m_repeatCount > 0 ? effectiveRepeatRate() : effectiveRepeatDelay();
+	// The count is left over from the last hold until repeating starts again.
+	const int count = isRepeating() ? m_repeatCount.load() : 0;
+	if (m_engine && m_activation.testFlags(ActivationBehavior::RepeatOnHold) && (m_maxRepeatCount < 0 || count < m_maxRepeatCount)) {
+		const int delay = count > 0 ? effectiveRepeatRate() : effectiveRepeatDelay();
 		if (delay >= 50) {
-			setupRepeatTimer();
-			m_repeatTim->start(delay);
+			const qint64 now = RepeatScheduler::nowNs();
+			const qint64 period = delay * 1000000LL;
+			qint64 deadline = now + period;
+			if (count > 0) {
+				// Repeats run at a fixed rate from the previous deadline, not from when the last evaluation finished, so they don't drift.
+				deadline = m_repeatDeadline + period;
+				if (deadline < now) {
+					// Late, either because the evaluation took longer than the repeat rate or the thread was busy.
+					// Catching up runs the missed repeats back-to-back, but not more than a few, otherwise skip to the next deadline after `now`.
+					const qint64 missed = (now - deadline) / period + 1;
+					if (!m_repeatCatchUp || missed > REPEAT_MAX_CATCHUP) {
+						deadline += missed * period;
+						m_engine->repeatScheduler()->addSkipped((int)missed);
+					}
+				}
+			}
+			m_engine->repeatScheduler()->schedule(this, deadline);
 			setRepeating(true);
 			return true;
 		}
@@ -389,6 +445,11 @@ bool DynamicScript::scheduleRepeatIfNeeded()
 }
 
 void DynamicScript::evaluate()
+{
+	runEvaluation(EvaluationRequest());
+}
+
+void DynamicScript::runEvaluation(const EvaluationRequest &req)
 {
 	if (m_state.testAnyFlags(State::CriticalErrorState) || m_activation == ActivationBehavior::NoActivation)
 		return;
@@ -406,26 +467,36 @@ void DynamicScript::evaluate()
 	}
 
 	if (!m_mutex.tryLockForRead(MUTEX_LOCK_TIMEOUT_MS)) {
-		qCDebug(lcPlugin) << "Mutex lock timeout for" << name;
+		// Properties are being changed, so try again later instead of losing this evaluation.
+		qCDebug(lcPlugin) << "Mutex lock timeout for" << name << "; evaluation re-queued.";
+		QMutexLocker lock(&m_queueMutex);
+		m_evalQueue.prepend(req);
+		postEvaluationQueue();
 		return;
 	}
 
+	const QString &expr = req.useCurrent ? m_expr : req.expr;
+	const int connectorValue = req.useCurrent ? m_connectorValue : req.connectorValue;
 	m_state.setFlag(State::EvaluatingNowState, true);
 	QJSValue res;
 	switch (m_inputType) {
 		case ScriptInputType::ExpressionInput:
-			res = m_engine->expressionValue(m_expr, name);
+			if (connectorValue > -1)
+				res = m_engine->connectorExpressionValue(expr, connectorValue, name);
+			else
+				res = m_engine->expressionValue(expr, name);
 			break;
 
 		case ScriptInputType::ScriptInput:
-			res = m_engine->scriptValue(m_file, m_expr, name);
+			res = m_engine->scriptValue(m_file, expr, name, connectorValue);
 			break;
 
 		case ScriptInputType::ModuleInput:
-			res = m_engine->moduleValue(m_file, m_moduleAlias, m_expr, name);
+			res = m_engine->moduleValue(m_file, m_moduleAlias, expr, name, connectorValue);
 			break;
 
 		default:
+			m_state.setFlag(State::EvaluatingNowState, false);
 			m_mutex.unlock();
 			return;
 	}
@@ -437,7 +508,7 @@ void DynamicScript::evaluate()
 		setPressed(false);
 	}
 	else if (!res.isUndefined() && !res.isNull()) {
-		stateUpdate(res.toString().toUtf8());
+		resultUpdate(res);
 	}
 
 	m_mutex.unlock();
@@ -448,6 +519,161 @@ void DynamicScript::evaluate()
 	Q_EMIT finished();
 }
 
+// Requests are evaluated one per event loop iteration in the instance's thread, so other work in the engine can run in between.
+void DynamicScript::enqueueEvaluation(bool connectorChange)
+{
+	EvaluationRequest req;
+	{
+		QReadLocker lock(&m_mutex);
+		req.expr = m_expr;
+		req.connectorValue = m_connectorValue;
+	}
+	req.useCurrent = false;
+
+	EvaluationQueuePolicy policy = m_queuePolicy;
+	if (policy == EvaluationQueuePolicy::DefaultQueuePolicy)
+		policy = connectorChange ? EvaluationQueuePolicy::LatestWins : EvaluationQueuePolicy::QueueAll;
+
+	QMutexLocker lock(&m_queueMutex);
+	switch (policy) {
+		case EvaluationQueuePolicy::LatestWins:
+			req.latestOnly = true;
+			if (!m_evalQueue.isEmpty() && m_evalQueue.last().latestOnly) {
+				m_evalQueue.last() = std::move(req);
+				++m_skippedEvals;
+				return;
+			}
+			break;
+
+		case EvaluationQueuePolicy::DropNew:
+			if (!m_evalQueue.isEmpty() || m_state.testFlags(State::EvaluatingNowState)) {
+				++m_droppedEvals;
+				return;
+			}
+			break;
+
+		default:
+			break;
+	}
+
+	if (m_evalQueue.size() >= m_maxQueueDepth) {
+		const int dropped = ++m_droppedEvals;
+		if (dropped % 100 == 1)
+			qCWarning(lcPlugin) << "Evaluation queue for" << name << "is full with" << m_evalQueue.size() << "requests waiting; dropped" << dropped << "request(s) so far.";
+		return;
+	}
+
+	m_evalQueue.enqueue(std::move(req));
+	if (m_evalQueue.size() > m_peakQueueDepth)
+		m_peakQueueDepth = m_evalQueue.size();
+	postEvaluationQueue();
+}
+
+void DynamicScript::postEvaluationQueue()
+{
+	// Only one delivery is ever pending, no matter how many places add to the queue before it runs.
+	if (m_queuePosted)
+		return;
+	m_queuePosted = true;
+	// Evaluations requested by Touch Portal go ahead of script timers and other background work waiting in the engine's thread.
+	if (m_engine)
+		m_engine->postLaneEvent(this, ScriptEngine::InputLane, [this]() { processEvaluationQueue(); });
+	else
+		QMetaObject::invokeMethod(this, "processEvaluationQueue", Qt::QueuedConnection);
+}
+
+bool DynamicScript::event(QEvent *ev)
+{
+	return ScriptEngine::dispatchLaneEvent(ev) || QObject::event(ev);
+}
+
+void DynamicScript::processEvaluationQueue()
+{
+	QMutexLocker lock(&m_queueMutex);
+	m_queuePosted = false;
+	if (m_evalQueue.isEmpty())
+		return;
+	const EvaluationRequest req = m_evalQueue.dequeue();
+	lock.unlock();
+
+	runEvaluation(req);
+
+	lock.relock();
+	if (!m_evalQueue.isEmpty())
+		postEvaluationQueue();
+}
+
+void DynamicScript::resultUpdate(const QJSValue &res)
+{
+	if (!createState())
+		return;
+	const QByteArray value = resultToUtf8(res);
+	if (!m_forceStateUpdate) {
+		QMutexLocker lock(&m_stateValueMutex);
+		if (m_stateValueSent && value == m_lastStateValue) {
+			++m_unchangedResults;
+			return;
+		}
+	}
+	stateUpdate(value);
+}
+
+int DynamicScript::queueDepth() const
+{
+	QMutexLocker lock(&m_queueMutex);
+	return m_evalQueue.size();
+}
+
+QStringList DynamicScript::pages() const
+{
+	QMutexLocker lock(&m_pagesMutex);
+	return m_pages;
+}
+
+void DynamicScript::setPages(const QStringList &pages)
+{
+	QMutexLocker lock(&m_pagesMutex);
+	m_pages = pages;
+	lock.unlock();
+	// Timers which were paused may be on a visible page now.
+	if (m_engine)
+		m_engine->resumeSuspendedTimers();
+}
+
+void DynamicScript::setHiddenPageBehavior(HiddenPageBehavior behavior)
+{
+	if (m_hiddenPageBehavior.exchange(behavior) == HiddenPageBehavior::PauseWhenHidden && m_engine)
+		m_engine->resumeSuspendedTimers();
+}
+
+bool DynamicScript::isOnCurrentPage() const
+{
+	// Until Touch Portal reports a page change we don't know what's showing.
+	if (DSE::tpCurrentPage.isEmpty())
+		return true;
+	QMutexLocker lock(&m_pagesMutex);
+	return m_pages.isEmpty() || m_pages.contains(QString::fromUtf8(DSE::tpCurrentPage));
+}
+
+HiddenPageBehavior DynamicScript::currentPageBehavior() const
+{
+	const HiddenPageBehavior behavior = m_hiddenPageBehavior;
+	if (behavior == HiddenPageBehavior::RunWhenHidden || isOnCurrentPage())
+		return HiddenPageBehavior::RunWhenHidden;
+	return behavior;
+}
+
+void DynamicScript::notePageUse(const QString &page)
+{
+	if (!m_learnPages || page.isEmpty())
+		return;
+	QMutexLocker lock(&m_pagesMutex);
+	if (!m_pages.contains(page)) {
+		m_pages.append(page);
+		qCDebug(lcPlugin) << "Instance" << name << "is used on page" << page;
+	}
+}
+
 void DynamicScript::evaluateDefault()
 {
 	// FIXME: TP v3.1 doesn't fire state change events based on the default value; v3.2 might.
@@ -462,7 +688,7 @@ QByteArray DynamicScript::getDefaultValue()
 		return QByteArray();
 
 	QReadLocker lock(&m_mutex);
-	const QString expr = m_defaultType == SavedDefaultType::CustomExprDefault ? m_defaultValue : m_defaultType == SavedDefaultType::LastExprDefault ? m_expr : QByteArray();
+	const QString expr = m_defaultType == SavedDefaultType::CustomExprDefault ? m_defaultValue : m_defaultType == SavedDefaultType::LastExprDefault ? expression() : QByteArray();
 	QJSValue res;
 	switch (m_inputType) {
 		case ScriptInputType::ExpressionInput:
@@ -494,7 +720,7 @@ QByteArray DynamicScript::getDefaultValue()
 		return m_defaultValue;
 
 	if (!res.isUndefined() && !res.isNull() && !res.isError())
-		return res.toString().toUtf8();
+		return resultToUtf8(res);
 
 	return QByteArray();
 }
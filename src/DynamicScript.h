@@ -26,7 +26,9 @@ to any 3rd-party components used within.
 #include <QDir>
 #include <QJsonObject>
 #include <QJSValue>
+#include <QMutex>
 #include <QObject>
+#include <QQueue>
 #include <QReadWriteLock>
 #include <QThread>
 #include <QTimer>
@@ -167,6 +169,37 @@ class DynamicScript : public QObject
 		//! This read-only property value is `true` if a Touch Portal State has been created for this script instance, `false` otherwise. This should always be `false` if \ref createState is `false`.
 		//! \n This property is read-only.  \sa createState
 		Q_PROPERTY(bool stateCreated READ stateCreated CONSTANT)
+		//! When `false` (default), an evaluation result which is the same as the last value sent to this instance's State is not sent again,
+		//! since Touch Portal would not do anything with it anyway. Set to `true` to send every result, for example if something in Touch Portal
+		//! may have changed the State value in the meantime. Explicit calls to \ref stateUpdate() always send the value. \sa unchangedResults
+		//! \since v1.2
+		Q_PROPERTY(bool forceStateUpdate READ forceStateUpdate WRITE setForceStateUpdate)
+		//! \}
+
+		//! \name Evaluation statistics.
+		//! \{
+
+		//! The number of evaluations which were skipped because a newer request, eg. a Connector (slider) value, replaced them before they had started.
+		//! This happens when \ref queuePolicy is `DSE.LatestWins`, or with `DSE.DefaultQueuePolicy` for Connector changes.
+		//! \n This property is read-only.  \sa queuePolicy
+		Q_PROPERTY(int skippedEvaluations READ skippedEvaluations CONSTANT)
+		//! The number of evaluation requests which were dropped, either because the queue already had \ref maxQueueDepth requests waiting,
+		//! or because \ref queuePolicy is `DSE.DropNew` and another evaluation was already waiting or running.
+		//! \n This property is read-only.  \sa queuePolicy, maxQueueDepth
+		//! \since v1.2
+		Q_PROPERTY(int droppedEvaluations READ droppedEvaluations CONSTANT)
+		//! The number of evaluation requests currently waiting to run.
+		//! \n This property is read-only.  \sa peakQueueDepth
+		//! \since v1.2
+		Q_PROPERTY(int queueDepth READ queueDepth CONSTANT)
+		//! The largest number of evaluation requests which were waiting to run at the same time.
+		//! \n This property is read-only.  \sa queueDepth
+		//! \since v1.2
+		Q_PROPERTY(int peakQueueDepth READ peakQueueDepth CONSTANT)
+		//! The number of evaluation results which were not sent as a State update because they were the same as the previously sent value.
+		//! \n This property is read-only.  \sa forceStateUpdate
+		//! \since v1.2
+		Q_PROPERTY(int unchangedResults READ unchangedResults CONSTANT)
 		//! \}
 
 		//! \name Action behaviour properties -- how the instance reacts to various input types like button press/release/hold.
@@ -185,6 +218,43 @@ class DynamicScript : public QObject
 		//! - `DSE.RepeatOnHold` - Ignores the initial button press and then starts repeating the evaluation after \ref effectiveRepeatDelay ms, until it is released.
 		//! - `DSE.OnRelease` - Evaluates expression only when button is released. This is the default behavior when using an action in Touch Portal's "On Pressed" button setup (which actually triggers actions upon button release).
 		Q_PROPERTY(DseNS::ActivationBehaviors activation READ activation WRITE setActivation)
+		//! Determines what happens to evaluation requests from Touch Portal actions or connectors which arrive while earlier ones are still waiting to run,
+		//! for example when a button is pressed repeatedly while a slow script is running. The value is one of the `DSE.EvaluationQueuePolicy` enumeration values:
+		//! - `DSE.DefaultQueuePolicy` - Connector (slider) changes only evaluate the latest value, and all other requests are queued. This is the default.
+		//! - `DSE.QueueAll` - Every request is evaluated in the order received, up to \ref maxQueueDepth waiting requests.
+		//! - `DSE.LatestWins` - Only the newest waiting request is evaluated; older ones which haven't started yet are skipped.
+		//! - `DSE.DropNew` - New requests are ignored while another evaluation is waiting or running.
+		//!
+		//! The policy can also be set with the "Queue" option of the script actions and connectors.
+		//! Calling \ref evaluate() directly from a script is not affected by this setting. \sa droppedEvaluations, skippedEvaluations, queueDepth
+		//! \since v1.2
+		Q_PROPERTY(DseNS::EvaluationQueuePolicy queuePolicy READ queuePolicy WRITE setQueuePolicy)
+		//! The maximum number of evaluation requests which may be waiting to run, after which further requests are dropped. Default is 100. \sa queuePolicy, droppedEvaluations
+		//! \since v1.2
+		Q_PROPERTY(int maxQueueDepth READ maxQueueDepth WRITE setMaxQueueDepth)
+		//! The names of Touch Portal pages on which this instance is used, in the same format as `TP.currentPageName()`, eg. `"(main)"` or `"folder/page"`.
+		//! An empty list (the default) means the instance is treated as showing on every page. The list may also be filled in automatically, see \ref learnPages.
+		//! \sa hiddenPageBehavior, isOnCurrentPage
+		//! \since v1.2
+		Q_PROPERTY(QStringList pages READ pages WRITE setPages)
+		//! When `true`, the current Touch Portal page is added to the \ref pages list every time a Touch Portal action or connector (slider) using this instance is activated.
+		//! Default is `false`.
+		//! \since v1.2
+		Q_PROPERTY(bool learnPages READ learnPages WRITE setLearnPages)
+		//! What happens to the timers started by this instance's scripts, with `setTimeout()` or `setInterval()`, while none of its \ref pages is showing in Touch Portal.
+		//! This can save a lot of processing for instances which only update "live" buttons, for example. The value is one of the `DSE.HiddenPageBehavior` enumeration values:
+		//! - `DSE.RunWhenHidden` - Timers always run. This is the default.
+		//! - `DSE.ThrottleWhenHidden` - Repeating timers run at most once per second while hidden.
+		//! - `DSE.PauseWhenHidden` - Timers do not run while hidden. When one of the pages is showing again, each timer which came due in the mean time runs once right away,
+		//!   and repeating timers then continue at their regular interval.
+		//!
+		//! In Private engines the timers belong to the engine's instance, and in the Shared engine to the instance which started the timer. \sa pages, learnPages
+		//! \since v1.2
+		Q_PROPERTY(DseNS::HiddenPageBehavior hiddenPageBehavior READ hiddenPageBehavior WRITE setHiddenPageBehavior)
+		//! `true` if the \ref pages list is empty or contains the page which is currently showing in Touch Portal.
+		//! \n This property is read-only.
+		//! \since v1.2
+		Q_PROPERTY(bool isOnCurrentPage READ isOnCurrentPage CONSTANT)
 		//! The default action repeat rate for this particular instance, in milliseconds. If `-1` (default) then the global default rate is used.  \sa, activeRepeatRate, DSE.defaultActionRepeatRate, repeatRateChanged()
 		Q_PROPERTY(int repeatRate READ repeatRate WRITE setRepeatRate NOTIFY repeatRateChanged)
 		//! The default action repeat delay for this particular instance, in milliseconds. If `-1` (default) then the global default rate is used.  \sa activeRepeatDelay, DSE.defaultActionRepeatDelay, repeatDelayChanged()
@@ -203,6 +273,12 @@ class DynamicScript : public QObject
 		Q_PROPERTY(int effectiveRepeatDelay READ effectiveRepeatDelay CONSTANT)
 		//! Get or set the maximum number of times this action will repeat when held. A value of `-1` (default) means to repeat an unlimited number of times. Setting the value to `0` effectively disables repeating.
 		Q_PROPERTY(int maxRepeatCount READ maxRepeatCount WRITE setMaxRepeatCount)
+		//! Held actions repeat at a fixed rate, measured from when each repeat was due rather than when the previous evaluation finished.
+		//! This property determines what happens when a repeat is late, for example because the evaluation took longer than the repeat rate.
+		//! If `false` (default) the missed repeats are skipped and the next one runs at its regular time. If `true` the missed repeats run
+		//! immediately one after another to "catch up", up to 3 of them (beyond that they are skipped anyway). \sa effectiveRepeatRate, DSE.engineStats()
+		//! \since v1.2
+		Q_PROPERTY(bool repeatCatchUp READ repeatCatchUp WRITE setRepeatCatchUp)
 		//! The number of times the current, or last, repeating action of this instance has repeated. The property is reset to zero when the \ref isRepeating property changes
 		//! from `false` to `true` -- that is, every time the repetition is about to start, but before the initial \ref effectiveRepeatDelay time has passed. \sa repeatCountChanged(), isRepeating, isPressed
 		//! \n This property is read-only.
@@ -252,6 +328,34 @@ class DynamicScript : public QObject
 		std::atomic_int m_activeRepeatDelay = -1;
 		std::atomic_int m_repeatCount = 0;
 		std::atomic_int m_maxRepeatCount = -1;
+		std::atomic_bool m_repeatCatchUp = false;
+		qint64 m_repeatDeadline = 0;  // deadline of the last repeat, on the RepeatScheduler clock
+		std::atomic_int m_skippedEvals = 0;
+		std::atomic_int m_unchangedResults = 0;
+		std::atomic_bool m_forceStateUpdate = false;
+		std::atomic_int m_droppedEvals = 0;
+		std::atomic_int m_peakQueueDepth = 0;
+		std::atomic_int m_maxQueueDepth = 100;
+		std::atomic<DseNS::EvaluationQueuePolicy> m_queuePolicy = DseNS::EvaluationQueuePolicy::DefaultQueuePolicy;
+		std::atomic<DseNS::HiddenPageBehavior> m_hiddenPageBehavior = DseNS::HiddenPageBehavior::RunWhenHidden;
+		std::atomic_bool m_learnPages = false;
+		QStringList m_pages;
+		mutable QMutex m_pagesMutex;
+		int m_connectorValue = -1;  // > -1 if m_expr contains a connector value placeholder
+		// Evaluation requests waiting to run in this instance's thread, guarded by m_queueMutex.
+		struct EvaluationRequest {
+			QString expr;
+			int connectorValue = -1;
+			bool useCurrent = true;   // evaluate the current expression instead of the one above
+			bool latestOnly = false;  // may be replaced by a newer request with the same flag
+		};
+		QQueue<EvaluationRequest> m_evalQueue;
+		mutable QMutex m_queueMutex;
+		bool m_queuePosted = false;  // processEvaluationQueue() is pending in our thread; also guarded by m_queueMutex
+		// Last value sent to the TP State, used to skip unchanged results. Guarded by m_stateValueMutex since scripts in other engines may also send updates.
+		QByteArray m_lastStateValue;
+		bool m_stateValueSent = false;
+		QMutex m_stateValueMutex;
 		QString m_expr;
 		QString m_file;
 		QString m_originalFile;
@@ -263,7 +367,6 @@ class DynamicScript : public QObject
 		QDateTime m_scriptLastMod;
 		QReadWriteLock m_mutex;
 		ScriptEngine * m_engine = nullptr;
-		QTimer *m_repeatTim = nullptr;
 
 	public:
 		const QByteArray name;
@@ -282,6 +385,10 @@ class DynamicScript : public QObject
 		QByteArray stateId() const { return createState() ? tpStateId : QByteArray(); }
 		bool stateCreated() const { return (m_state & TpStateCreatedFlag); }
 
+		bool forceStateUpdate() const { return m_forceStateUpdate; }
+		void setForceStateUpdate(bool force) { m_forceStateUpdate = force; }
+		int unchangedResults() const { return m_unchangedResults; }
+
 		QByteArray stateCategory() const { return tpStateCategory.isEmpty() ? QByteArrayLiteral(PLUGIN_DYNAMIC_STATES_PARENT) : tpStateCategory; }
 		void stateCategory(const QString &value) { tpStateCategory = value.toUtf8(); }
 
@@ -293,7 +400,7 @@ class DynamicScript : public QObject
 
 		QString scriptFile() const { return m_originalFile; }
 		QString scriptFileResolved() const { return m_file; }
-		QString expression() const { return m_expr; }
+		QString expression() const;
 		QString moduleAlias() const { return m_moduleAlias; }
 
 		DseNS::PersistenceType persistence() const { return m_persist; }
@@ -302,6 +409,26 @@ class DynamicScript : public QObject
 
 		QJSValue &dataStorage();
 
+		int skippedEvaluations() const { return m_skippedEvals; }
+		int droppedEvaluations() const { return m_droppedEvals; }
+		int peakQueueDepth() const { return m_peakQueueDepth; }
+		int queueDepth() const;
+
+		DseNS::EvaluationQueuePolicy queuePolicy() const { return m_queuePolicy; }
+		void setQueuePolicy(DseNS::EvaluationQueuePolicy policy) { m_queuePolicy = policy; }
+		int maxQueueDepth() const { return m_maxQueueDepth; }
+		void setMaxQueueDepth(int depth) { m_maxQueueDepth = qMax(1, depth); }
+
+		QStringList pages() const;
+		void setPages(const QStringList &pages);
+		bool learnPages() const { return m_learnPages; }
+		void setLearnPages(bool learn) { m_learnPages = learn; }
+		DseNS::HiddenPageBehavior hiddenPageBehavior() const { return m_hiddenPageBehavior; }
+		void setHiddenPageBehavior(DseNS::HiddenPageBehavior behavior);
+		bool isOnCurrentPage() const;
+		// Returns RunWhenHidden if the instance is on the current page, or its hiddenPageBehavior otherwise.
+		DseNS::HiddenPageBehavior currentPageBehavior() const;
+
 		int autoDeleteDelay() const { return m_autoDeleteDelay; }
 		void setAutoDeleteDelay(int ms) { m_autoDeleteDelay = ms; }
 
@@ -327,6 +454,9 @@ class DynamicScript : public QObject
 		int maxRepeatCount() const { return m_maxRepeatCount; }
 		void setMaxRepeatCount(int count) { m_maxRepeatCount = count; }
 
+		bool repeatCatchUp() const { return m_repeatCatchUp; }
+		void setRepeatCatchUp(bool catchUp) { m_repeatCatchUp = catchUp; }
+
 		int repeatRate() const { return m_repeatRate; }
 		void setRepeatRate(int ms) {
 			if (ms < 50)
@@ -380,11 +510,11 @@ class DynamicScript : public QObject
 		int effectiveRepeatRate() const { return m_activeRepeatRate > 0 ? m_activeRepeatRate.load() : (m_repeatRate > 0 ? m_repeatRate.load() : DSE::defaultRepeatRate.load()); }
 		int effectiveRepeatDelay() const { return m_activeRepeatDelay > 0 ? m_activeRepeatDelay.load() : (m_repeatDelay > 0 ? m_repeatDelay.load() : DSE::defaultRepeatDelay.load()); }
 
-		bool setExpressionProperties(const QString &expr);
-		bool setScriptProperties(const QString &file, const QString &expr);
-		bool setModuleProperties(const QString &file, const QString &alias, const QString &expr);
+		bool setExpressionProperties(const QString &expr, int connectorValue = -1);
+		bool setScriptProperties(const QString &file, const QString &expr, int connectorValue = -1);
+		bool setModuleProperties(const QString &file, const QString &alias, const QString &expr, int connectorValue = -1);
 		bool setProperties(DseNS::ScriptInputType type, const QString &expr, const QString &file = QString(), const QString &alias = QString(), bool ignoreErrors = false);
-		bool setExpression(const QString &expr);
+		bool setExpression(const QString &expr, int connectorValue = -1);
 
 		bool setEngine(ScriptEngine *se);
 		ScriptEngine *engine() const { return m_engine; }
@@ -401,6 +531,11 @@ class DynamicScript : public QObject
 			if (createState()) {
 				// FIXME: TP v3.1 doesn't fire state change events based on the default value; v3.2 might.
 				createTpState(/*m_defaultType != DseNS::SavedDefaultType::LastExprDefault*/);
+				{
+					QMutexLocker lock(&m_stateValueMutex);
+					m_lastStateValue = value;
+					m_stateValueSent = true;
+				}
 				Q_EMIT dataReady(tpStateId, value);
 				//qCDebug(lcPlugin) << "DynamicScript instance" << name << "sending result:" << value;
 			}
@@ -514,8 +649,9 @@ class DynamicScript : public QObject
 
 		void setPressed(bool isPressed);
 		void serializeStoredData();
-		void setupRepeatTimer(bool create = true);
-		void repeatEvaluate();
+		// Called by the engine's RepeatScheduler, `deadlineNs` is when the repeat was scheduled to run.
+		void repeatEvaluate(qint64 deadlineNs);
+		void processEvaluationQueue();
 		QByteArray getDefaultValue();
 
 	private:
@@ -526,9 +662,21 @@ class DynamicScript : public QObject
 		Q_SIGNAL void finished();
 
 		//void moveToMainThread();
-		bool setExpr(const QString &expr);
+		bool setExpr(const QString &expr, int connectorValue = -1);
 		bool setFile(const QString &file);
 		bool scheduleRepeatIfNeeded();
+		// Schedules processEvaluationQueue() to run in our thread unless it already is. Expects m_queueMutex to be locked.
+		void postEvaluationQueue();
+		// Adds a request to evaluate the current expression to the queue, as per the queuePolicy. `connectorChange` is used with the default policy.
+		void enqueueEvaluation(bool connectorChange = false);
+		void runEvaluation(const EvaluationRequest &req);
+		// Adds `page` to the pages list if learnPages is enabled.
+		void notePageUse(const QString &page);
+		// Ends any held-button repetition and waits for a repeat which is running in the engine thread right now to return.
+		// Must be called before deleting an instance while holding DSE::instances_mutex(), which the running script may be waiting for.
+		void stopRepeating();
+		// Sends an evaluation result as a State update, unless it's the same as the last value sent and forceStateUpdate is false.
+		void resultUpdate(const QJSValue &res);
 
 		inline void createTpState(bool useActualDefault = false)
 		{
@@ -545,12 +693,21 @@ class DynamicScript : public QObject
 		{
 			if (m_state.testFlags(TpStateCreatedFlag)) {
 				m_state.setFlag(TpStateCreatedFlag, false);
+				{
+					QMutexLocker lock(&m_stateValueMutex);
+					m_stateValueSent = false;
+				}
 				Q_EMIT stateRemove(tpStateId);
 				qCDebug(lcPlugin) << "Removed instance State" << tpStateId;
 			}
 		}
 
+	protected:
+		bool event(QEvent *ev) override;
+
+	private:
 		friend class Plugin;
+		friend class RepeatScheduler;
 		Q_DISABLE_COPY(DynamicScript)
 };
 
@@ -41,6 +41,11 @@ to any 3rd-party components used within.
 #define SETTINGS_KEY_ACT_RPT_RATE    "actRepeatRate"
 #define SETTINGS_KEY_ACT_RPT_DELAY   "actRepeatDelay"
 
+// Connector notifications are collected for up to this long and then stored all at once.
+#define CONNECTOR_BATCH_WINDOW_MS    50
+// Store a batch right away once it gets this large.
+#define CONNECTOR_BATCH_MAX_SIZE     250
+
 using namespace DseNS;
 using namespace Strings;
 
@@ -112,6 +117,21 @@ static DseNS::SavedDefaultType stringToSavedDefaultType(QStringView str)
 	}
 }
 
+static DseNS::EvaluationQueuePolicy stringToQueuePolicy(QStringView str)
+{
+	// "Default",
+	// "Queue All",
+	// "Latest Wins",
+	// "Drop New"
+	if (str.startsWith('Q'))
+		return EvaluationQueuePolicy::QueueAll;
+	if (str.startsWith('L'))
+		return EvaluationQueuePolicy::LatestWins;
+	if (str.startsWith(QLatin1String("Dr")))
+		return EvaluationQueuePolicy::DropNew;
+	return EvaluationQueuePolicy::DefaultQueuePolicy;
+}
+
 static DseNS::ActivationBehaviors stringToActivationType(QStringView str)
 {
 	//	"On Press",
@@ -153,6 +173,10 @@ Plugin::Plugin(const QString &tpHost, uint16_t tpPort, const QByteArray &pluginI
 		DSE::valueStatePrefix = m_pluginId + '.';
 
 	client->setHostProperties(tpHost, tpPort);
+	// Coalesce rapid state updates; only the latest value of each state is sent per event loop pass.
+	client->setSendQueueEnabled(true);
+	// Slider drags flood us with connector changes; only the latest one in each batch needs handling.
+	client->setConnectorChangeCoalescing(true);
 	// Set up constant IDs of things we send to TP like states and choice list updates.
 	{
 		auto const &tokens = tokenStrings();
@@ -193,6 +217,16 @@ Plugin::Plugin(const QString &tpHost, uint16_t tpPort, const QByteArray &pluginI
 	m_loadSettingsTmr.setInterval(750);
 	connect(&m_loadSettingsTmr, &QTimer::timeout, this, &Plugin::loadStartupSettings);
 
+	// Checks for script evaluations running over the time limit, schedules idle-time garbage collection, and publishes the related statistics.
+	m_watchdogTmr.setInterval(100);
+	connect(&m_watchdogTmr, &QTimer::timeout, this, &Plugin::onWatchdogTimer);
+
+	// TP sends bursts of connector notifications at startup and on page changes.
+	m_connectorBatchTmr.setSingleShot(true);
+	m_connectorBatchTmr.setInterval(CONNECTOR_BATCH_WINDOW_MS);
+	connect(&m_connectorBatchTmr, &QTimer::timeout, this, &Plugin::flushConnectorNotifications);
+	connect(ConnectorData::instance(), &ConnectorData::connectorsUpdated, this, [this]() { m_connectorFeedbackPlans.clear(); });
+
 	Q_EMIT tpConnect();
 	//QMetaObject::invokeMethod(this, "start", Qt::QueuedConnection);
 }
@@ -231,6 +265,8 @@ void Plugin::quit()
 		return;
 	g_shuttingDown = true;
 
+	m_watchdogTmr.stop();
+	m_connectorBatchTmr.stop();
 	QWriteLocker tl(g_timersDataMutex);
 	for (int timId : g_timersData->keys())
 		killTimer(timId);
@@ -251,15 +287,22 @@ void Plugin::quit()
 	savePluginSettings();
 	saveAllInstances();
 
+	// Running repeats may need the instances lock, so they have to be finished before it is taken for deleting.
+	for (DynamicScript *ds : DSE::instances_const())
+		ds->stopRepeating();
 	QWriteLocker il(DSE::instances_mutex());
 	qDeleteAll(*DSE::instances());
 	DSE::instances()->clear();
 	il.unlock();
 
+	ScriptEngine::clearEnginePool();
+	// The Shared engines are also in the engines list, so they're removed from it first.
+	ScriptEngine::deleteSharedShards();
 	QWriteLocker el(DSE::engines_mutex());
 	qDeleteAll(*DSE::engines());
 	DSE::engines()->clear();
 	el.unlock();
+	ScriptEngine::shutdownThreadPool();
 
 	if (clientThread) {
 		clientThread->quit();
@@ -272,10 +315,15 @@ void Plugin::initEngine()
 {
 	new ScriptEngine(QByteArrayLiteral("Shared"));
 	connect(ScriptEngine::instance(), &ScriptEngine::engineError, this, &Plugin::onEngineError, Qt::QueuedConnection);
+	ScriptEngine::createSharedShards();
+	for (ScriptEngine * const se : ScriptEngine::sharedShards())
+		connect(se, &ScriptEngine::engineError, this, &Plugin::onEngineError, Qt::QueuedConnection);
 	connect(this, &Plugin::setActionRepeatProperty, DSE::sharedInstance, &DSE::setActionRepeatProperty, Qt::QueuedConnection);
 	connect(DSE::sharedInstance, &DSE::defaultActionRepeatRateChanged, this, &Plugin::onActionRepeatRateChanged, Qt::QueuedConnection);
 	connect(DSE::sharedInstance, &DSE::defaultActionRepeatDelayChanged, this, &Plugin::onActionRepeatDelayChanged, Qt::QueuedConnection);
 
+	m_watchdogTmr.start();
+
 	// Default "anonymous" shared worker instance.
 	DynamicScript *ds = DSE::defaultScriptInstance = new DynamicScript(QByteArrayLiteral("Default Shared"));
 	ds->setEngine(ScriptEngine::instance());
@@ -376,7 +424,7 @@ bool Plugin::loadScriptInstance(const QByteArray &name) const
 		ds->setEngine(getOrCreateEngine(ds->engineName()));
 	}
 	else {
-		ds->setEngine(ScriptEngine::instance());
+		ds->setEngine(ScriptEngine::sharedInstanceFor(name));
 	}
 	QMetaObject::invokeMethod(ds, "evaluateDefault", Qt::QueuedConnection);
 	return true;
@@ -396,6 +444,16 @@ void Plugin::loadStartupScript()
 		if (DSE::defaultScriptInstance->setScriptProperties(file, QString())) {
 			qCInfo(lcPlugin) << "Loading startup script" << DSE::defaultScriptInstance->scriptFileResolved();
 			QMetaObject::invokeMethod(DSE::defaultScriptInstance, "evaluate", Qt::QueuedConnection);
+			// Additional Shared engines get the same startup environment.
+			const QString resolved = DSE::defaultScriptInstance->scriptFileResolved();
+			const QByteArray instName = DSE::defaultScriptInstance->name;
+			for (ScriptEngine * const se : ScriptEngine::sharedShards()) {
+				QMetaObject::invokeMethod(se, [=]() {
+					const QJSValue res = se->scriptValue(resolved, QString(), instName);
+					if (res.isError())
+						se->throwError(res, instName);
+				}, Qt::QueuedConnection);
+			}
 			return;
 		}
 		raiseScriptError(DSE::defaultScriptInstance->name,
@@ -409,7 +467,7 @@ ScriptEngine *Plugin::getOrCreateEngine(const QByteArray &name, bool failIfMissi
 {
 	ScriptEngine *se = DSE::engine(name);
 	if (!se && !failIfMissing) {
-		se = DSE::insert(name, new ScriptEngine(name));
+		se = DSE::insert(name, ScriptEngine::acquirePrivateEngine(name));
 		// Instance-specific errors from background tasks.
 		connect(se, &ScriptEngine::engineError, this, &Plugin::onEngineError, Qt::QueuedConnection);
 		sendEngineLists();
@@ -443,6 +501,8 @@ void Plugin::removeInstance(DynamicScript *ds, bool removeFromGlobal, bool remov
 		return;
 	ScriptEngine *se = ds->engine();
 	ScriptEngine::instance()->clearInstanceData(ds);
+	if (se && se->isSharedInstance() && se != ScriptEngine::instance())
+		se->clearInstanceData(ds);
 	ds->removeTpState();
 	disconnect(ds, nullptr, this, nullptr);
 	disconnect(ds, nullptr, client, nullptr);
@@ -470,6 +530,10 @@ void Plugin::removeEngine(ScriptEngine *se, bool removeFromGlobal, bool removeSc
 
 	bool scriptsRemoved = false;
 	if (removeScripts) {
+		for (DynamicScript *ds : DSE::instances_const()) {
+			if (ds->engine() == se)
+				ds->stopRepeating();
+		}
 		QWriteLocker l(DSE::instances_mutex());
 		DSE::ScriptState::iterator it = DSE::instances()->begin();
 		while (it != DSE::instances()->end()) {
@@ -537,7 +601,12 @@ void Plugin::sendInstanceLists() const
 
 void Plugin::sendEngineLists() const
 {
-	QByteArrayList nameArry = DSE::engineKeys();
+	// Shared engines are picked by instance name, not chosen as a script's engine scope.
+	QByteArrayList nameArry;
+	for (ScriptEngine * const se : DSE::engines_const()) {
+		if (!se->isSharedInstance())
+			nameArry << se->name();
+	}
 	std::sort(nameArry.begin(), nameArry.end());
 	nameArry.prepend(tokenToName(AT_Private));
 	nameArry.prepend(tokenToName(AT_Shared));
@@ -599,14 +668,16 @@ void Plugin::sendScriptState(DynamicScript *ds, const QByteArray &value) const
 
 void Plugin::updateConnectors(const QMultiMap<QString, QVariant> &qry, int value, float rangeMin, float rangeMax) const
 {
-	const auto connectors = ConnectorData::instance()->records(qry);
-	for (const auto &conn : connectors) {
-		float rmin = (float)conn.otherData.value(QLatin1String("rangeMin")).toString("0").toDouble();
-		float rmax = (float)conn.otherData.value(QLatin1String("rangeMax")).toString("0").toDouble();
-		if (rmin == 0.0f || rmax == 0.0f)
-			continue;
-		int connVal = qRound(Utils::rangeValueToPercent(value, qBound(rangeMin, rmin, rangeMax), qBound(rangeMin, rmax, rangeMax)));
-		Q_EMIT tpConnectorUpdateShort(conn.shortId, connVal);
+	const QByteArray key = ConnectorData::queryKey(qry);
+	auto plan = m_connectorFeedbackPlans.constFind(key);
+	if (plan == m_connectorFeedbackPlans.cend()) {
+		QVector<ConnectorFeedback> targets = ConnectorData::instance()->feedbackTargets(qry);
+		targets.removeIf([](const ConnectorFeedback &cf) { return cf.rangeMin == 0.0f || cf.rangeMax == 0.0f; });
+		plan = m_connectorFeedbackPlans.insert(key, targets);
+	}
+	for (const ConnectorFeedback &cf : plan.value()) {
+		int connVal = qRound(Utils::rangeValueToPercent(value, qBound(rangeMin, cf.rangeMin, rangeMax), qBound(rangeMin, cf.rangeMax, rangeMax)));
+		Q_EMIT tpConnectorUpdateShort(cf.shortId, connVal);
 	}
 }
 
@@ -723,6 +794,38 @@ void Plugin::onDsFinished()
 void Plugin::onActionRepeatRateChanged(int ms) const { updateActionRepeatProperties(ms, AT_Rate); }
 void Plugin::onActionRepeatDelayChanged(int ms) const { updateActionRepeatProperties(ms, AT_Delay); }
 
+void Plugin::onWatchdogTimer()
+{
+	ScriptEngine::checkEvaluationTimeouts();
+	ScriptEngine::scheduleGarbageCollection();
+
+	const quint32 timeouts = ScriptEngine::evaluationTimeoutCount();
+	if (timeouts != m_lastEvalTimeouts) {
+		m_lastEvalTimeouts = timeouts;
+		Q_EMIT tpStateUpdate(m_stateIds[SID_EvalTimeoutCount], QByteArray::number(timeouts));
+	}
+	const qint64 maxMs = qRound64(ScriptEngine::evaluationMaxDurationMs());
+	if (maxMs != m_lastEvalMaxMs) {
+		m_lastEvalMaxMs = maxMs;
+		Q_EMIT tpStateUpdate(m_stateIds[SID_EvalMaxDuration], QByteArray::number(maxMs));
+	}
+
+	// memory statistics change often, so only check them about once per second
+	if (++m_watchdogTicks < 10)
+		return;
+	m_watchdogTicks = 0;
+	const QByteArray heap = QByteArray::number(ScriptEngine::totalHeapSize() / (1024.0 * 1024.0), 'f', 1);
+	if (heap != m_lastHeapSize) {
+		m_lastHeapSize = heap;
+		Q_EMIT tpStateUpdate(m_stateIds[SID_EnginesHeapSize], heap);
+	}
+	const quint32 gcCount = ScriptEngine::garbageCollectionCount();
+	if (gcCount != m_lastGcCount) {
+		m_lastGcCount = gcCount;
+		Q_EMIT tpStateUpdate(m_stateIds[SID_GcCount], QByteArray::number(gcCount));
+	}
+}
+
 void Plugin::onTpConnected(const TPClientQt::TPInfo &info, const QJsonObject &settings)
 {
 	qCInfo(lcPlugin).nospace().noquote()
@@ -875,13 +978,15 @@ void Plugin::scriptAction(TPClientQt::MessageType type, int act, const QMap<QStr
 	// Stop possible deletion timer for temporary instance.
 	if (ds->persistence() == PersistenceType::PersistTemporary)
 		stopDeletionTimer(ds->name);
+	// Actions and connectors can only be activated on the page which is showing.
+	ds->notePageUse(QString::fromUtf8(DSE::tpCurrentPage));
 
 	// Always unset the pressed state first because we cannot have the same action running concurrently.
 	ds->setPressedState(false);
 	// If used "On-Hold" and this is a release event, invoke eval method and exit now.
 	// The script should handle whatever it needs to do with the data it already has.
 	if (type == TPClientQt::MessageType::up) {
-		QMetaObject::invokeMethod(ds, "evaluate", Qt::QueuedConnection);
+		ds->enqueueEvaluation();
 		return;
 	}
 
@@ -891,6 +996,10 @@ void Plugin::scriptAction(TPClientQt::MessageType type, int act, const QMap<QStr
 	// If action is used in On-Hold then it may have separate on-press/hold/release behaviors.
 	else
 		ds->setActivation(stringToActivationType(dataMap.value("activation")));
+	// The queue policy option is not present in actions created with older plugin versions, in which case the current policy is kept.
+	const QString &queueParam = dataMap.value("queue");
+	if (!queueParam.isEmpty())
+		ds->setQueuePolicy(stringToQueuePolicy(queueParam));
 
 	if (act != AID_Update) {
 		ScriptEngine *se;
@@ -909,9 +1018,9 @@ void Plugin::scriptAction(TPClientQt::MessageType type, int act, const QMap<QStr
 		else if (scope == EngineInstanceType::PrivateInstance) {
 			se = getOrCreateEngine(dvName);
 		}
-		// Otherwise use the Shared instance.
+		// Otherwise use the Shared instance, or one of them if there are several.
 		else {
-			se = ScriptEngine::instance();
+			se = ScriptEngine::sharedInstanceFor(dvName);
 		}
 		ds->setEngine(se);
 
@@ -943,24 +1052,23 @@ void Plugin::scriptAction(TPClientQt::MessageType type, int act, const QMap<QStr
 		}
 	}  // act != AID_Update
 
-	QString expression = dataMap.value("expr");
-	if (connectorValue > -1) {
-		expression.replace(QLatin1String("${connector_value}"), QString::number(connectorValue), Qt::CaseInsensitive);
-	}
+	// Any "${connector_value}" placeholder is kept in the expression and the value is passed along separately, so the engine can reuse
+	// the expression compiled as a function instead of compiling new source text for each connector value.
+	const QString &expression = dataMap.value("expr");
 	bool ok = false;
 	switch (act)
 	{
 		case AID_Eval:
-			ok = ds->setExpressionProperties(expression);
+			ok = ds->setExpressionProperties(expression, connectorValue);
 			break;
 		case AID_Load:
-			ok = ds->setScriptProperties(dataMap.value("file").trimmed(), expression);
+			ok = ds->setScriptProperties(dataMap.value("file").trimmed(), expression, connectorValue);
 			break;
 		case AID_Import:
-			ok = ds->setModuleProperties(dataMap.value("file").trimmed(), dataMap.value("alias").trimmed(), expression);
+			ok = ds->setModuleProperties(dataMap.value("file").trimmed(), dataMap.value("alias").trimmed(), expression, connectorValue);
 			break;
 		case AID_Update:
-			ok = ds->setExpression(expression);
+			ok = ds->setExpression(expression, connectorValue);
 			break;
 	}
 	if (!ok) {
@@ -974,7 +1082,8 @@ void Plugin::scriptAction(TPClientQt::MessageType type, int act, const QMap<QStr
 	if (type == TPClientQt::MessageType::down)
 		ds->setPressedState(true);
 
-	QMetaObject::invokeMethod(ds, "evaluate", Qt::QueuedConnection);
+	// With the default policy, connector (slider) changes only need the latest value evaluated while button presses are all queued.
+	ds->enqueueEvaluation(type == TPClientQt::MessageType::connectorChange);
 }
 
 void Plugin::pluginAction(TPClientQt::MessageType type, int act, const QMap<QString, QString> &dataMap, qint32 connectorValue)
@@ -1014,6 +1123,10 @@ void Plugin::instanceControlAction(quint8 act, const QMap<QString, QString> &dat
 	{
 		case CA_DelScript: {
 			if (type) {
+				for (DynamicScript *ds : DSE::instances_const()) {
+					if (type == 255 || type == (quint8)ds->instanceType())
+						ds->stopRepeating();
+				}
 				QWriteLocker l(DSE::instances_mutex());
 				DSE::ScriptState::iterator it = DSE::instances()->begin();
 				while (it != DSE::instances()->end()) {
@@ -1058,7 +1171,10 @@ void Plugin::instanceControlAction(quint8 act, const QMap<QString, QString> &dat
 				//sendStateLists();
 			}
 			else if (ScriptEngine *se = DSE::engine(dvName)) {
-				removeEngine(se);
+				if (se->isSharedInstance())
+					qCCritical(lcPlugin) << "Cannot delete the shared engine instance" << dvName;
+				else
+					removeEngine(se);
 			}
 			else {
 				qCCritical(lcPlugin) << "Engine instance not found for name:" << dvName;
@@ -1081,8 +1197,11 @@ void Plugin::instanceControlAction(quint8 act, const QMap<QString, QString> &dat
 						se->reset();
 				}
 			}
-			if (type == 255 || type == (quint8)EngineInstanceType::SharedInstance)
+			if (type == 255 || type == (quint8)EngineInstanceType::SharedInstance) {
 				ScriptEngine::instance()->reset();
+				for (ScriptEngine * const se : ScriptEngine::sharedShards())
+					se->reset();
+			}
 			return;
 		}
 
@@ -1190,6 +1309,21 @@ void Plugin::handleSettings(const QJsonObject &settings) const
 	if (!(val = settings.value(tokenToName(ST_LoadScriptAtStart))).isUndefined()) {
 		QSettings().setValue(SETTINGS_GROUP_PLUGIN "/" SETTINGS_KEY_STARTUP_SCRIPT, val.toString().trimmed());
 	}
+	if (!(val = settings.value(tokenToName(ST_EvalTimeLimit))).isUndefined()) {
+		ScriptEngine::setEvaluationTimeLimit(val.toString().toInt());
+	}
+	if (!(val = settings.value(tokenToName(ST_SharedEngines))).isUndefined()) {
+		// only used at startup
+		ScriptEngine::setSharedShardCount(qBound(1, val.toString().toInt(), 16));
+	}
+	if (!(val = settings.value(tokenToName(ST_EngineThreads))).isUndefined()) {
+		// only affects engines created after this
+		ScriptEngine::setThreadPoolSize(qBound(-1, val.toString().toInt(), 64));
+	}
+	if (!(val = settings.value(tokenToName(ST_EnginePoolSize))).isUndefined()) {
+		// spare engines are created or removed in the background
+		ScriptEngine::setEnginePoolSize(qBound(0, val.toString().toInt(), 10));
+	}
 	if (!g_startupComplete && !(val = settings.value(tokenToName(ST_SettingsVersion))).isUndefined()) {
 		// Currently not actually doing anything based on stored plugin settings, except a log message. Reserved for future use.
 		if (val.toString().isEmpty())
@@ -1199,7 +1333,16 @@ void Plugin::handleSettings(const QJsonObject &settings) const
 	}
 }
 
-void Plugin::parseConnectorNotification(const QJsonObject &msg) const
+void Plugin::flushConnectorNotifications()
+{
+	m_connectorBatchTmr.stop();
+	if (m_pendingConnectors.isEmpty())
+		return;
+	qCDebug(lcPlugin) << "Storing" << m_pendingConnectors.size() << "connector notification(s)";
+	ConnectorData::instance()->insert(std::exchange(m_pendingConnectors, QVector<ConnectorRecord>()));
+}
+
+void Plugin::parseConnectorNotification(const QJsonObject &msg)
 {
 	//qCDebug(lcPlugin) << msg;
 	const QString longConnId(msg.value(QLatin1String("connectorId")).toString());
@@ -1252,7 +1395,12 @@ void Plugin::parseConnectorNotification(const QJsonObject &msg) const
 			break;
 	}
 
-	ConnectorData::instance()->insert(cr);
+	m_pendingConnectors.append(cr);
+	// The window starts at the first notification of a burst and isn't extended by the others, so no update is delayed for longer than that.
+	if (m_pendingConnectors.size() >= CONNECTOR_BATCH_MAX_SIZE)
+		flushConnectorNotifications();
+	else if (!m_connectorBatchTmr.isActive())
+		m_connectorBatchTmr.start();
 }
 
 #include "moc_Plugin.cpp"
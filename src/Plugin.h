@@ -20,10 +20,12 @@ to any 3rd-party components used within.
 
 #pragma once
 
+#include <QHash>
 #include <QObject>
 #include <QTimer>
 
 #include "dse_strings.h"
+#include "ConnectorData.h"
 #include "TPClientQt.h"
 #include "JSError.h"
 
@@ -117,6 +119,8 @@ class Plugin : public QObject
 		void onActionRepeatDelayChanged(int ms) const;
 		void onTpConnected(const TPClientQt::TPInfo &info, const QJsonObject &settings);
 		void onTpMessage(TPClientQt::MessageType type, const QJsonObject &msg);
+		void onWatchdogTimer();
+		void flushConnectorNotifications();
 
 	private:
 		void dispatchAction(TPClientQt::MessageType type, const QJsonObject &msg);
@@ -126,12 +130,22 @@ class Plugin : public QObject
 		void setActionRepeatRate(TPClientQt::MessageType type, quint8 act, const QMap<QString, QString> &dataMap, qint32 connectorValue) const;
 
 		void handleSettings(const QJsonObject &settings) const;
-		void parseConnectorNotification(const QJsonObject &msg) const;
+		void parseConnectorNotification(const QJsonObject &msg);
 
 		const QByteArray m_pluginId;
 		TPClientQt *client = nullptr;
 		QThread *clientThread = nullptr;
 		QTimer m_loadSettingsTmr;
+		QTimer m_watchdogTmr;
+		QTimer m_connectorBatchTmr;
+		QVector<ConnectorRecord> m_pendingConnectors;
+		// Connectors to update for each updateConnectors() query, cleared whenever connector data changes.
+		mutable QHash<QByteArray, QVector<ConnectorFeedback>> m_connectorFeedbackPlans;
+		quint32 m_lastEvalTimeouts = 0;
+		qint64 m_lastEvalMaxMs = -1;
+		QByteArray m_lastHeapSize;
+		quint32 m_lastGcCount = 0;
+		quint8 m_watchdogTicks = 0;
 		QByteArray m_stateIds[Strings::SID_ENUM_MAX];
 		QByteArray m_choiceListIds[Strings::CLID_ENUM_MAX];
 
@@ -0,0 +1,163 @@
+/*
+Dynamic Script Engine Plugin for Touch Portal
+Copyright Maxim Paperno; all rights reserved.
+
+This file may be used under the terms of the GNU
+General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+A copy of the GNU General Public License is available at <http://www.gnu.org/licenses/>.
+
+This project may also use 3rd-party Open Source software under the terms
+of their respective licenses. The copyright notice above does not apply
+to any 3rd-party components used within.
+*/
+
+#include "RepeatScheduler.h"
+
+#include <QThread>
+#include <QTimer>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+
+#include "DynamicScript.h"
+
+RepeatScheduler::RepeatScheduler(QObject *p) :
+  QObject(p),
+  m_timer{new QTimer(this)}
+{
+	m_timer->setSingleShot(true);
+	m_timer->setTimerType(Qt::PreciseTimer);
+	connect(m_timer, &QTimer::timeout, this, &RepeatScheduler::onTimeout);
+	m_heap.reserve(8);
+}
+
+qint64 RepeatScheduler::nowNs()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void RepeatScheduler::schedule(DynamicScript *ds, qint64 deadlineNs)
+{
+	QMutexLocker lock(&m_mutex);
+	removeEntry(ds);
+	m_heap.push_back({deadlineNs, ds});
+	std::push_heap(m_heap.begin(), m_heap.end(), std::greater<Entry>());
+	++m_scheduled;
+	m_pending = (int)m_heap.size();
+	if (m_pending > m_peakPending)
+		m_peakPending = m_pending.load();
+
+	// The timer only needs to change if this is now the earliest deadline. While a repeat is running onTimeout() re-arms it afterwards anyway.
+	if (m_armedDeadline > -1 && m_armedDeadline <= deadlineNs)
+		return;
+	if (QThread::currentThread() == thread()) {
+		if (!m_firing)
+			arm();
+	}
+	else if (!m_armQueued) {
+		m_armQueued = true;
+		QMetaObject::invokeMethod(this, [this]() {
+			QMutexLocker lock(&m_mutex);
+			m_armQueued = false;
+			arm();
+		}, Qt::QueuedConnection);
+	}
+}
+
+void RepeatScheduler::cancel(DynamicScript *ds, bool wait)
+{
+	QMutexLocker lock(&m_mutex);
+	// The timer is left running; if it was armed for this entry then onTimeout() will find nothing due and re-arm for the next one.
+	removeEntry(ds);
+	if (wait && QThread::currentThread() != thread()) {
+		if (m_firing != ds)
+			return;
+		while (m_firing == ds)
+			m_firingDone.wait(&m_mutex);
+		// The repeat which was running may have scheduled the next one.
+		removeEntry(ds);
+	}
+}
+
+void RepeatScheduler::removeEntry(DynamicScript *ds)
+{
+	const auto it = std::find_if(m_heap.begin(), m_heap.end(), [ds](const Entry &e) { return e.ds == ds; });
+	if (it == m_heap.end())
+		return;
+	m_heap.erase(it);
+	std::make_heap(m_heap.begin(), m_heap.end(), std::greater<Entry>());
+	m_pending = (int)m_heap.size();
+}
+
+// m_mutex must be locked and this must run in our thread.
+void RepeatScheduler::arm()
+{
+	if (m_heap.empty()) {
+		m_armedDeadline = -1;
+		m_timer->stop();
+		return;
+	}
+	const qint64 deadline = m_heap.front().deadline;
+	if (deadline == m_armedDeadline && m_timer->isActive())
+		return;
+	m_armedDeadline = deadline;
+	const qint64 remain = deadline - nowNs();
+	// Round up so the timer never fires before the deadline.
+	m_timer->start(remain > 0 ? int((remain + 999999) / 1000000) : 0);
+}
+
+void RepeatScheduler::onTimeout()
+{
+	QMutexLocker lock(&m_mutex);
+	m_armedDeadline = -1;
+	// Only run what was queued when we started; an instance which is catching up and re-schedules itself in the past will run on the next pass,
+	// after any other pending events.
+	size_t count = m_heap.size();
+	while (count-- && !m_heap.empty()) {
+		const qint64 now = nowNs();
+		if (m_heap.front().deadline > now)
+			break;
+		std::pop_heap(m_heap.begin(), m_heap.end(), std::greater<Entry>());
+		const Entry e = m_heap.back();
+		m_heap.pop_back();
+		m_pending = (int)m_heap.size();
+
+		const qint64 late = now - e.deadline;
+		m_lateLastNs = late;
+		if (late > m_lateMaxNs)
+			m_lateMaxNs = late;
+		m_lateTotalNs += late;
+		++m_fired;
+
+		m_firing = e.ds;
+		lock.unlock();
+		e.ds->repeatEvaluate(e.deadline);
+		lock.relock();
+		m_firing = nullptr;
+		m_firingDone.wakeAll();
+	}
+	arm();
+}
+
+QVariantMap RepeatScheduler::statistics() const
+{
+	const quint32 fired = m_fired;
+	return QVariantMap {
+		{ QStringLiteral("scheduled"),       (quint32)m_scheduled },
+		{ QStringLiteral("fired"),           fired },
+		{ QStringLiteral("skipped"),         (quint32)m_skipped },
+		{ QStringLiteral("pending"),         (int)m_pending },
+		{ QStringLiteral("peakPending"),     (int)m_peakPending },
+		{ QStringLiteral("lastJitterMs"),    m_lateLastNs / 1.0e6 },
+		{ QStringLiteral("maxJitterMs"),     m_lateMaxNs / 1.0e6 },
+		{ QStringLiteral("averageJitterMs"), fired ? m_lateTotalNs / 1.0e6 / fired : 0.0 },
+	};
+}
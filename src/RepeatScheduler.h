@@ -0,0 +1,87 @@
+/*
+Dynamic Script Engine Plugin for Touch Portal
+Copyright Maxim Paperno; all rights reserved.
+
+This file may be used under the terms of the GNU
+General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+A copy of the GNU General Public License is available at <http://www.gnu.org/licenses/>.
+
+This project may also use 3rd-party Open Source software under the terms
+of their respective licenses. The copyright notice above does not apply
+to any 3rd-party components used within.
+*/
+
+#pragma once
+
+#include <QMutex>
+#include <QObject>
+#include <QVariantMap>
+#include <QWaitCondition>
+
+#include <atomic>
+#include <vector>
+
+class QTimer;
+class DynamicScript;
+
+// Runs the held-button repeats of all script instances in one engine with a single timer. Pending repeats are kept in a min-heap ordered by
+// their deadline (on the monotonic clock, in ns), and the timer is only armed for the earliest one. Each instance has at most one pending repeat.
+// The scheduler lives in its engine's thread and calls DynamicScript::repeatEvaluate() from there; schedule() and cancel() are thread-safe.
+class RepeatScheduler : public QObject
+{
+		Q_OBJECT
+	public:
+		explicit RepeatScheduler(QObject *p = nullptr);
+
+		// Current time on the clock used for deadlines.
+		static qint64 nowNs();
+
+		// Schedules (or re-schedules) `ds` to repeat at `deadlineNs`.
+		void schedule(DynamicScript *ds, qint64 deadlineNs);
+		// Removes any pending repeat of `ds`. With `wait` it also blocks until a repeat of `ds` which is already running in the scheduler thread has returned,
+		// so that `ds` can be safely deleted afterwards. Since that repeat runs script code, the caller must not hold any lock which scripts may need,
+		// such as DSE::instances_mutex().
+		void cancel(DynamicScript *ds, bool wait = false);
+		// Adds to the count of repeats which were skipped because they were late (see DynamicScript::repeatCatchUp).
+		void addSkipped(int count) { m_skipped += count; }
+
+		// Number of scheduled repeats and timing statistics. Safe to call from any thread.
+		QVariantMap statistics() const;
+
+	private Q_SLOTS:
+		void onTimeout();
+
+	private:
+		struct Entry {
+			qint64 deadline;
+			DynamicScript *ds;
+			bool operator>(const Entry &other) const { return deadline > other.deadline; }
+		};
+		void removeEntry(DynamicScript *ds);
+		void arm();
+
+		// Heap storage keeps its capacity, so after the first few presses scheduling doesn't allocate.
+		std::vector<Entry> m_heap;
+		QMutex m_mutex;
+		QWaitCondition m_firingDone;
+		DynamicScript *m_firing = nullptr;
+		QTimer *m_timer = nullptr;
+		qint64 m_armedDeadline = -1;
+		bool m_armQueued = false;
+
+		std::atomic_uint m_scheduled {0};
+		std::atomic_uint m_fired {0};
+		std::atomic_uint m_skipped {0};
+		std::atomic_int m_pending {0};
+		std::atomic_int m_peakPending {0};
+		std::atomic<qint64> m_lateLastNs {0};
+		std::atomic<qint64> m_lateMaxNs {0};
+		std::atomic<qint64> m_lateTotalNs {0};
+};
@@ -20,6 +20,7 @@ to any 3rd-party components used within.
 
 #include "ScriptEngine.h"
 #include "Plugin.h"
+#include "RepeatScheduler.h"
 #include "ScriptingLibrary/AbortController.h"
 #include "ScriptingLibrary/Clipboard.h"
 #include "ScriptingLibrary/Dir.h"
@@ -28,11 +29,17 @@ to any 3rd-party components used within.
 #include "ScriptingLibrary/TPAPI.h"
 #include "ScriptingLibrary/Util.h"
 
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <chrono>
+#include <QFileSystemWatcher>
+
 #if !SCRIPT_ENGINE_USE_QML
 // use privates to inject Locale and Date/Number formatting features normally in QQmlEngine into QJSEngine
 #include <private/qqmllocale_p.h>
 #include <private/qv4global_p.h>
 #include <private/qv4engine_p.h>
+#include <private/qv4mm_p.h>
 #include "ScriptingLibrary/DOMException.h"
 #include "ScriptingLibrary/XmlHttpRequest.h"
 #endif
@@ -40,11 +47,517 @@ to any 3rd-party components used within.
 using namespace Utils;
 using namespace ScriptLib;
 
+#define CONNECTOR_VALUE_PLACEHOLDER  "${connector_value}"
+#define CONNECTOR_VALUE_ARGUMENT     "__dse_connector_value"
+
+constexpr static int EXPRESSION_CACHE_DEFAULT_CAPACITY = 200;
+constexpr static int GC_DEFAULT_IDLE_DELAY_MS = 3000;
+constexpr static qint64 GC_DEFAULT_HEAP_BUDGET = 32 * 1024 * 1024;
+
+namespace {
+
+inline bool isIdentifierChar(QChar c) { return c.isLetterOrNumber() || c == '_' || c == '$'; }
+
+// Returns true if a '/' following character `prev` (at `prevIdx` in `expr`) would be a division operator, vs. the start of a regular expression literal.
+bool isDivisionContext(const QString &expr, QChar prev, int prevIdx)
+{
+	if (prev.isNull())
+		return false;
+	if (prev == ')' || prev == ']' || prev == '}' || prev == '"' || prev == '\'' || prev == '`')
+		return true;
+	if (!isIdentifierChar(prev))
+		return false;
+	// an identifier or number, unless it's a keyword which can precede an expression
+	int start = prevIdx;
+	while (start > 0 && isIdentifierChar(expr.at(start - 1)))
+		--start;
+	static const char * const keywords[] = { "return", "typeof", "instanceof", "in", "of", "new", "delete", "void", "throw", "case", "do", "else", "yield", "await" };
+	const QStringView word = QStringView(expr).mid(start, prevIdx - start + 1);
+	for (const char *kw : keywords) {
+		if (word == QLatin1String(kw))
+			return false;
+	}
+	return true;
+}
+
+// Prepares an expression to be used as the body of a function. If `bindPlaceholder` is true, the "${connector_value}" placeholder becomes a reference
+// to a variable named CONNECTOR_VALUE_ARGUMENT. A minimal lexer tells code apart from strings, template literals and comments. Inside template literals
+// the placeholder becomes a substitution of the variable, and in comments it is left as-is. Returns false if the placeholder appears where a variable
+// can't take the place of literal text (inside a quoted string or adjacent to an identifier), if the expression contains a regular expression literal,
+// which isn't lexed, or if it would behave differently inside a function than at global scope (unbalanced brackets or use of `arguments`).
+bool prepareExpressionBody(const QString &expr, QString &out, bool bindPlaceholder)
+{
+	enum Context { Code, SingleQuote, DoubleQuote, Template, LineComment, BlockComment };
+	static const QLatin1String placeholder(CONNECTOR_VALUE_PLACEHOLDER);
+	const int len = expr.length();
+	const int phLen = placeholder.size();
+	Context ctx = Code;
+	QVector<int> templateDepths;  // brace depth at which each nested template literal substitution started
+	int braceDepth = 0;
+	int parenDepth = 0;  // combined depth of ( and [
+	QChar prev;        // last non-space character seen in code
+	int prevIdx = -1;  // and its index
+	out.clear();
+	out.reserve(len + 32);
+
+	for (int i = 0; i < len; ) {
+		const QChar c = expr.at(i);
+		if (bindPlaceholder && c == '$' && ctx < LineComment && QStringView(expr).mid(i, phLen).compare(placeholder, Qt::CaseInsensitive) == 0) {
+			if (ctx == Template) {
+				out += QLatin1String("${" CONNECTOR_VALUE_ARGUMENT "}");
+			}
+			else if (ctx == Code) {
+				if ((i > 0 && (isIdentifierChar(expr.at(i - 1)) || expr.at(i - 1) == '.')) || (i + phLen < len && isIdentifierChar(expr.at(i + phLen))))
+					return false;
+				out += QLatin1String(CONNECTOR_VALUE_ARGUMENT);
+				prev = ')';  // acts as an operand
+				prevIdx = i + phLen - 1;
+			}
+			else {
+				return false;
+			}
+			i += phLen;
+			continue;
+		}
+
+		switch (ctx) {
+			case Code:
+				if (c == '"') {
+					ctx = DoubleQuote;
+				}
+				else if (c == '\'') {
+					ctx = SingleQuote;
+				}
+				else if (c == '`') {
+					ctx = Template;
+				}
+				else if (c == '/' && i + 1 < len && expr.at(i + 1) == '/') {
+					ctx = LineComment;
+				}
+				else if (c == '/' && i + 1 < len && expr.at(i + 1) == '*') {
+					ctx = BlockComment;
+					out += QLatin1String("/*");
+					i += 2;
+					continue;
+				}
+				else if (c == '/' && !isDivisionContext(expr, prev, prevIdx)) {
+					return false;
+				}
+				else if (c == '{') {
+					++braceDepth;
+				}
+				else if (c == '}') {
+					if (!templateDepths.isEmpty() && templateDepths.last() == braceDepth) {
+						templateDepths.removeLast();
+						ctx = Template;
+					}
+					else if (--braceDepth < 0) {
+						return false;
+					}
+				}
+				else if (c == '(' || c == '[') {
+					++parenDepth;
+				}
+				else if (c == ')' || c == ']') {
+					// eg. "a) + (b" would be a syntax error at global scope but not once wrapped in "return (...)"
+					if (--parenDepth < 0)
+						return false;
+				}
+				else if (c == 'a' && (i == 0 || (!isIdentifierChar(expr.at(i - 1)) && expr.at(i - 1) != '.')) && QStringView(expr).mid(i, 9) == QLatin1String("arguments")
+				         && (i + 9 == len || !isIdentifierChar(expr.at(i + 9)))) {
+					return false;
+				}
+				if (!c.isSpace()) {
+					prev = c;
+					prevIdx = i;
+				}
+				break;
+
+			case SingleQuote:
+			case DoubleQuote:
+			case Template:
+				if (c == '\\' && i + 1 < len) {
+					out += c;
+					out += expr.at(i + 1);
+					i += 2;
+					continue;
+				}
+				if (ctx == Template && c == '$' && i + 1 < len && expr.at(i + 1) == '{') {
+					templateDepths.append(braceDepth);
+					ctx = Code;
+					prev = '{';
+					prevIdx = i + 1;
+					out += QLatin1String("${");
+					i += 2;
+					continue;
+				}
+				if (c == (ctx == SingleQuote ? '\'' : ctx == DoubleQuote ? '"' : '`')) {
+					ctx = Code;
+					prev = c;
+					prevIdx = i;
+				}
+				break;
+
+			case LineComment:
+				if (c == '\n')
+					ctx = Code;
+				break;
+
+			case BlockComment:
+				if (c == '*' && i + 1 < len && expr.at(i + 1) == '/') {
+					ctx = Code;
+					out += QLatin1String("*/");
+					i += 2;
+					continue;
+				}
+				break;
+		}
+		out += c;
+		++i;
+	}
+	return (ctx == Code || ctx == LineComment) && !parenDepth && !braceDepth && templateDepths.isEmpty();
+}
+
+}  // namespace
+
 ScriptEngine *ScriptEngine::sharedInstance = nullptr;
 
-ScriptEngine::ScriptEngine(const QByteArray &instanceName, QObject *p) :
-  QObject(p), dse{new DSE(this)}, tpapi{new TPAPI(this)}, ulib{new Util(this)},
-  m_name(instanceName)
+// Evaluation watchdog, which interrupts evaluations running longer than the time limit. The registry of all engine instances is used by
+// checkEvaluationTimeouts(), which runs on the Plugin's thread.
+namespace {
+
+struct EngineRegistry
+{
+	QMutex mutex;
+	QVector<ScriptEngine *> engines;
+};
+Q_GLOBAL_STATIC(EngineRegistry, g_engineRegistry)
+
+std::atomic_int g_evalTimeLimitMs {10000};
+std::atomic_uint g_evalTimeouts {0};
+std::atomic<qint64> g_evalMaxNs {0};
+std::atomic_uint g_gcCount {0};
+
+inline qint64 monotonicNs() { return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count(); }
+
+inline void updateMax(std::atomic<qint64> &max, qint64 value)
+{
+	qint64 prev = max;
+	while (value > prev && !max.compare_exchange_weak(prev, value))
+		;
+}
+
+void registerEngine(ScriptEngine *se)
+{
+	QMutexLocker lock(&g_engineRegistry->mutex);
+	g_engineRegistry->engines.append(se);
+}
+
+void unregisterEngine(ScriptEngine *se)
+{
+	QMutexLocker lock(&g_engineRegistry->mutex);
+	g_engineRegistry->engines.removeOne(se);
+}
+
+}  // namespace
+
+// Shared worker threads for Private engines. Each engine is bound to one thread for its whole life since a QJSEngine and all of its objects
+// can only be used from the thread they live in; new engines are assigned to the thread with the fewest engines.
+namespace {
+
+struct EngineThreadPool
+{
+	QMutex mutex;
+	int size = 0;                      // 0 to give each engine its own thread
+	QVector<QThread *> threads;
+	QHash<QThread *, int> engineCounts;
+	quint32 threadsCreated = 0;
+};
+Q_GLOBAL_STATIC(EngineThreadPool, g_threadPool)
+
+// Returns a pool thread for a new engine, or null if the engine should have its own thread.
+QThread *acquireEngineThread()
+{
+	QMutexLocker lock(&g_threadPool->mutex);
+	EngineThreadPool &pool = *g_threadPool;
+	if (!pool.size)
+		return nullptr;
+	QThread *thread = nullptr;
+	int minCount = 0;
+	for (int i = 0; i < pool.threads.size() && i < pool.size; ++i) {
+		const int count = pool.engineCounts.value(pool.threads.at(i));
+		if (!thread || count < minCount) {
+			minCount = count;
+			thread = pool.threads.at(i);
+		}
+	}
+	// start another thread rather than sharing one, until there are as many as the pool size
+	if (!thread || (minCount > 0 && pool.threads.size() < pool.size)) {
+		thread = new QThread();
+		thread->setObjectName(QStringLiteral("ScriptEngine worker %1").arg(++pool.threadsCreated));
+		thread->start();
+		pool.threads.append(thread);
+	}
+	++pool.engineCounts[thread];
+	return thread;
+}
+
+void releaseEngineThread(QThread *thread)
+{
+	QMutexLocker lock(&g_threadPool->mutex);
+	EngineThreadPool &pool = *g_threadPool;
+	int &count = pool.engineCounts[thread];
+	if (--count > 0)
+		return;
+	// threads beyond the current pool size are stopped once they're unused
+	const int idx = pool.threads.indexOf(thread);
+	if (idx < pool.size)
+		return;
+	pool.engineCounts.remove(thread);
+	pool.threads.remove(idx);
+	lock.unlock();
+	thread->quit();
+	thread->wait(1000);
+	delete thread;
+}
+
+}  // namespace
+
+// Marks the duration of an evaluation for the watchdog. Must be created with m_mutex locked and finished before it is unlocked.
+class ScriptEngine::EvaluationScope
+{
+	public:
+		explicit EvaluationScope(ScriptEngine *engine) : e(engine) { e->beginEvaluation(); }
+		~EvaluationScope() { if (e) e->endEvaluation(); }
+
+		// Ends the evaluation. If it was interrupted by the watchdog, `res` is replaced with an error describing the timeout.
+		void finish(QJSValue &res)
+		{
+			const bool interrupted = e->endEvaluation();
+			if (interrupted && res.isError()) {
+				QJSValue err = e->se->newErrorObject(QJSValue::RangeError, ScriptEngine::tr("Evaluation interrupted after exceeding the time limit of %1 ms").arg(g_evalTimeLimitMs));
+				err.setProperty(QStringLiteral("cause"), res);
+				res = err;
+			}
+			e = nullptr;
+		}
+
+	private:
+		ScriptEngine *e;
+		Q_DISABLE_COPY(EvaluationScope)
+};
+
+void ScriptEngine::beginEvaluation()
+{
+	QMutexLocker lock(&m_watchdogMutex);
+	m_evalStartNs = monotonicNs();
+	m_evalInterrupted = false;
+}
+
+bool ScriptEngine::endEvaluation()
+{
+	QMutexLocker lock(&m_watchdogMutex);
+	const qint64 elapsed = monotonicNs() - m_evalStartNs;
+	m_evalStartNs = 0;
+	m_evalLastNs = elapsed;
+	m_lastActivityNs = monotonicNs();
+	m_heapBytes = heapSize();
+	m_gcDirty = true;
+	updateMax(m_evalMaxNs, elapsed);
+	updateMax(g_evalMaxNs, elapsed);
+	if (!m_evalInterrupted)
+		return false;
+	m_evalInterrupted = false;
+	se->setInterrupted(false);
+	++m_evalTimeouts;
+	++g_evalTimeouts;
+	return true;
+}
+
+void ScriptEngine::setEvaluationTimeLimit(int ms) { g_evalTimeLimitMs = qMax(0, ms); }
+int ScriptEngine::evaluationTimeLimit() { return g_evalTimeLimitMs; }
+quint32 ScriptEngine::evaluationTimeoutCount() { return g_evalTimeouts; }
+double ScriptEngine::evaluationMaxDurationMs() { return g_evalMaxNs / 1.0e6; }
+
+void ScriptEngine::checkEvaluationTimeouts()
+{
+	const qint64 limitNs = g_evalTimeLimitMs * Q_INT64_C(1000000);
+	if (!limitNs)
+		return;
+	const qint64 now = monotonicNs();
+	QMutexLocker rlock(&g_engineRegistry->mutex);
+	for (ScriptEngine *e : qAsConst(g_engineRegistry->engines)) {
+		QMutexLocker lock(&e->m_watchdogMutex);
+		if (!e->m_evalStartNs || e->m_evalInterrupted || now - e->m_evalStartNs < limitNs)
+			continue;
+		// setInterrupted() is safe to call from another thread; the evaluation aborts with an error at the next opportunity.
+		e->m_evalInterrupted = true;
+		e->se->setInterrupted(true);
+		qCWarning(lcPlugin) << "Interrupting evaluation in engine" << e->m_name << "after" << (now - e->m_evalStartNs) / 1000000 << "ms";
+	}
+}
+
+void ScriptEngine::scheduleGarbageCollection()
+{
+	const qint64 now = monotonicNs();
+	QMutexLocker rlock(&g_engineRegistry->mutex);
+	for (ScriptEngine *e : qAsConst(g_engineRegistry->engines)) {
+		if (!e->m_gcDirty || e->m_gcQueued)
+			continue;
+		const qint64 idleNs = e->m_gcIdleDelayMs * Q_INT64_C(1000000);
+		const bool idle = idleNs && now - e->m_lastActivityNs >= idleNs;
+		// If the live heap itself is over budget then wait for it to double before collecting again, instead of collecting on every check.
+		const qint64 budget = e->m_gcHeapBudget;
+		const bool overBudget = budget && e->m_heapBytes > qMax(budget, e->m_heapAfterGc * 2);
+		if (!idle && !overBudget)
+			continue;
+		e->m_gcQueued = true;
+		e->postLaneEvent(e, BackgroundLane, [e]() { e->collectIdleGarbage(); });
+	}
+}
+
+void ScriptEngine::collectIdleGarbage()
+{
+	m_gcQueued = false;
+	// If something is running, or about to, then try again later.
+	if (!m_gcDirty || !m_mutex.tryLock())
+		return;
+	QElapsedTimer timer;
+	timer.start();
+	se->collectGarbage();
+	const qint64 pause = timer.nsecsElapsed();
+	const qint64 heap = heapSize();
+	m_mutex.unlock();
+
+	m_gcDirty = false;
+	m_heapBytes = heap;
+	m_heapAfterGc = heap;
+	m_gcLastPauseNs = pause;
+	m_gcTotalPauseNs += pause;
+	updateMax(m_gcMaxPauseNs, pause);
+	++m_gcCount;
+	++g_gcCount;
+	//qCDebug(lcPlugin) << "GC for engine" << m_name << "took" << pause / 1000 << "us; heap now" << heap;
+}
+
+// Event lanes
+
+namespace {
+const QEvent::Type g_laneEventType = static_cast<QEvent::Type>(QEvent::registerEventType());
+}
+
+class LaneEvent : public QEvent
+{
+	public:
+		LaneEvent(ScriptEngine *engine, ScriptEngine::EventLane lane, std::function<void()> &&func) :
+		  QEvent(g_laneEventType), engine(engine), lane(lane), func(std::move(func)), postedNs(monotonicNs())
+		{
+			if (lane == ScriptEngine::InputLane)
+				++engine->m_pendingInput;
+		}
+
+		// Also runs if the event is discarded because the receiver was deleted.
+		~LaneEvent()
+		{
+			if (lane == ScriptEngine::InputLane)
+				--engine->m_pendingInput;
+		}
+
+		ScriptEngine *engine;
+		const ScriptEngine::EventLane lane;
+		const std::function<void()> func;
+		const qint64 postedNs;
+};
+
+void ScriptEngine::postLaneEvent(QObject *receiver, EventLane lane, std::function<void()> &&func)
+{
+	static const int priorities[EventLaneCount] { Qt::HighEventPriority, Qt::NormalEventPriority, Qt::LowEventPriority };
+	QCoreApplication::postEvent(receiver, new LaneEvent(this, lane, std::move(func)), priorities[lane]);
+}
+
+bool ScriptEngine::dispatchLaneEvent(QEvent *ev)
+{
+	if (ev->type() != g_laneEventType)
+		return false;
+	LaneEvent *le = static_cast<LaneEvent *>(ev);
+	le->engine->recordLaneWait(le->lane, monotonicNs() - le->postedNs);
+	le->func();
+	return true;
+}
+
+void ScriptEngine::recordLaneWait(EventLane lane, qint64 waitNs)
+{
+	LaneStatistics &ls = m_laneStats[lane];
+	++ls.events;
+	ls.lastWaitNs = waitNs;
+	ls.totalWaitNs += waitNs;
+	updateMax(ls.maxWaitNs, waitNs);
+}
+
+bool ScriptEngine::event(QEvent *ev)
+{
+	return dispatchLaneEvent(ev) || QObject::event(ev);
+}
+
+QVariantMap ScriptEngine::laneStatistics() const
+{
+	static const char *names[EventLaneCount] { "input", "timers", "background" };
+	QVariantMap ret;
+	for (int i = 0; i < EventLaneCount; ++i) {
+		const LaneStatistics &ls = m_laneStats[i];
+		const quint32 events = ls.events;
+		QVariantMap lane {
+			{ QStringLiteral("events"),        events },
+			{ QStringLiteral("lastWaitMs"),    ls.lastWaitNs / 1.0e6 },
+			{ QStringLiteral("maxWaitMs"),     ls.maxWaitNs / 1.0e6 },
+			{ QStringLiteral("averageWaitMs"), events ? ls.totalWaitNs / 1.0e6 / events : 0.0 },
+		};
+		if (i == InputLane)
+			lane.insert(QStringLiteral("pending"), (int)m_pendingInput);
+		ret.insert(QLatin1String(names[i]), lane);
+	}
+	return ret;
+}
+
+qint64 ScriptEngine::totalHeapSize()
+{
+	qint64 total = 0;
+	QMutexLocker rlock(&g_engineRegistry->mutex);
+	for (const ScriptEngine *e : qAsConst(g_engineRegistry->engines))
+		total += e->m_heapBytes;
+	return total;
+}
+
+quint32 ScriptEngine::garbageCollectionCount() { return g_gcCount; }
+
+QVariantMap ScriptEngine::gcStatistics() const
+{
+	return QVariantMap {
+		{ QStringLiteral("idleDelayMs"),     (int)m_gcIdleDelayMs },
+		{ QStringLiteral("heapBudgetBytes"), (qint64)m_gcHeapBudget },
+		{ QStringLiteral("heapBytes"),       (qint64)m_heapBytes },
+		{ QStringLiteral("heapBytesAfterGc"),(qint64)m_heapAfterGc },
+		{ QStringLiteral("collections"),     (quint32)m_gcCount },
+		{ QStringLiteral("lastPauseMs"),     m_gcLastPauseNs / 1.0e6 },
+		{ QStringLiteral("maxPauseMs"),      m_gcMaxPauseNs / 1.0e6 },
+		{ QStringLiteral("totalPauseMs"),    m_gcTotalPauseNs / 1.0e6 },
+	};
+}
+
+QVariantMap ScriptEngine::watchdogStatistics() const
+{
+	return QVariantMap {
+		{ QStringLiteral("timeLimitMs"),    (int)g_evalTimeLimitMs },
+		{ QStringLiteral("timeouts"),       (quint32)m_evalTimeouts },
+		{ QStringLiteral("maxDurationMs"),  m_evalMaxNs / 1.0e6 },
+		{ QStringLiteral("lastDurationMs"), m_evalLastNs / 1.0e6 },
+	};
+}
+
+ScriptEngine::ScriptEngine(const QByteArray &instanceName, bool initInThread, int shardIndex, QObject *p) :
+  QObject(p), dse{new DSE(this)}, tpapi{new TPAPI(this)}, ulib{new Util(this, this)}, m_repeatScheduler{new RepeatScheduler(this)},
+  m_name(instanceName), m_isShared(shardIndex > 0), m_shardIndex(shardIndex), m_exprCacheCapacity(EXPRESSION_CACHE_DEFAULT_CAPACITY),
+  m_gcIdleDelayMs(GC_DEFAULT_IDLE_DELAY_MS), m_gcHeapBudget(GC_DEFAULT_HEAP_BUDGET)
 {
 	setObjectName(QLatin1String("ScriptEngine: ") + instanceName);
 	if (!sharedInstance) {
@@ -72,26 +585,59 @@ ScriptEngine::ScriptEngine(const QByteArray &instanceName, QObject *p) :
 
 	tpapi->connectSignals(Plugin::instance);
 	tpapi->connectSlots(Plugin::instance, Qt::QueuedConnection);
+	// Timers paused while their instance's pages were hidden may need to run now.
+	connect(Plugin::instance, &Plugin::tpBroadcast, ulib, [this](const QString &event) {
+		if (event == QLatin1String("pageChange"))
+			resumeSuspendedTimers();
+	});
 
-	initScriptEngine();
+	if (!initInThread)
+		initScriptEngine();
 
 	if (!m_isShared) {
 		dse->privateInstance = true;
 		dse->instanceName = m_name;
 	}
 
-	m_thread = new QThread();
-	m_thread->setObjectName(objectName());
+	// Private engines may share a worker thread with other engines (see setThreadPoolSize()). The thread's event loop runs one event at a time,
+	// so evaluations and timers of each engine are still serialized and in order; anything which needs to live in the engine's thread,
+	// like DynamicScript instances, just uses thread() as before.
+	if (!m_isShared)
+		m_thread = acquireEngineThread();
+	m_ownsThread = !m_thread;
+	if (m_ownsThread) {
+		m_thread = new QThread();
+		m_thread->setObjectName(objectName());
+	}
 	moveToThread(m_thread);
-	m_thread->start();
+	if (m_ownsThread)
+		m_thread->start();
 
+	registerEngine(this);
+
+	if (initInThread)
+		QMetaObject::invokeMethod(this, [this]() { initScriptEngine(); }, Qt::QueuedConnection);
 }
 
 ScriptEngine::~ScriptEngine()
 {
+	unregisterEngine(this);
+	// Objects with timers have to be deleted in the thread they live in, which is still running (and may be shared with other engines).
+	// This waits for that thread, so it's done before locking m_mutex, which a script running there may be about to need.
+	const auto deleteThreadObjects = [this]() {
+		delete ulib;
+		ulib = nullptr;
+		delete m_repeatScheduler;
+		m_repeatScheduler = nullptr;
+		delete m_fileWatcher;
+		m_fileWatcher = nullptr;
+	};
+	if (m_thread && m_thread->isRunning() && QThread::currentThread() != m_thread)
+		Utils::runOnThreadSync(m_thread, deleteThreadObjects);
+	else
+		deleteThreadObjects();
+
 	QMutexLocker lock(&m_mutex);
-	delete ulib;
-	ulib = nullptr;
 	delete tpapi;
 	tpapi = nullptr;
 	delete dse;
@@ -100,12 +646,15 @@ ScriptEngine::~ScriptEngine()
 	se = nullptr;
 	delete m_nam;
 	m_nam = nullptr;
-	if (m_thread) {
+	if (m_thread && m_ownsThread) {
 		m_thread->quit();
 		m_thread->wait(1000);
 		delete m_thread;
-		m_thread = nullptr;
 	}
+	else if (m_thread) {
+		releaseEngineThread(m_thread);
+	}
+	m_thread = nullptr;
 	//qCDebug(lcPlugin) << this << m_name << "Destroyed";
 }
 
@@ -118,7 +667,20 @@ void ScriptEngine::initScriptEngine()
 		se->deleteLater();
 		se = nullptr;
 	}
+	m_expressionFunctions.clear();
+	m_connectorFunctions.clear();
+	m_exprCacheSize = 0;
+	{
+		// the new engine has to evaluate script files again; also re-read them in case a change was missed by the file watcher
+		QMutexLocker flock(&m_scriptFilesMutex);
+		for (ScriptFileRecord &rec : m_scriptFiles) {
+			rec.evaluatedVersion = 0;
+			rec.stale = true;
+		}
+	}
 
+	QElapsedTimer initTimer;
+	initTimer.start();
 	se = new SCRIPT_ENGINE_BASE_TYPE();
 	se->setProperty("ScriptEngine", QVariant::fromValue(this));  // used by library scripts to access this instance
 
@@ -151,7 +713,10 @@ void ScriptEngine::initScriptEngine()
 	se->globalObject().setProperty("Locale", se->newQMetaObject(&QQmlLocale::staticMetaObject));  // HACK - makes Locale namespace enums available
 #endif
 
+	const qint64 heapBeforeLibrary = heapSize();
+	// Core library which extends built-in types and sets up global helpers; the larger self-contained modules are loaded on first use.
 	evalScript(QStringLiteral(":/scripts/jslib.min.js"));
+	installLibraryModuleStubs();
 	//evalScript(QStringLiteral(":/scripts/collections.js"));
 	//evalScript(QStringLiteral(":/scripts/color.js"));
 	//evalScript(QStringLiteral(":/scripts/date.js"));
@@ -169,10 +734,380 @@ void ScriptEngine::initScriptEngine()
 	modules.setProperty("clipboard", se->newQObject(ScriptLib::Clipboard::instance()));
 	se->registerModule("clipboard", modules.property("clipboard"));
 
+	{
+		QMutexLocker slock(&m_statsMutex);
+		m_initStats.initTimeNs = initTimer.nsecsElapsed();
+		m_initStats.heapBeforeLibrary = heapBeforeLibrary;
+		m_initStats.heapAfterInit = heapSize();
+		m_libraryModuleStats.clear();
+	}
+	m_heapBytes = m_initStats.heapAfterInit;
+	m_heapAfterGc = m_initStats.heapAfterInit;
+
+	m_ready = true;
 	Q_EMIT engineInitComplete();
 	qCDebug(lcPlugin) << "Engine init completed for" << m_name;
 }
 
+// Library modules which are only compiled and evaluated the first time a script uses one of the listed global names or properties.
+// Each module is in its own ":/scripts/<name>.min.js" resource file.
+static const struct { const char *name; const char *symbols; } g_lazyLibraryModules[] = {
+	{ "color",        "Color,tinycolor" },
+	{ "env",          "Env" },
+	{ "fetch",        "Headers,Response,Request,Net,GlobalRequestDefaults" },
+	{ "sprintf",      "sprintf" },
+	{ "stringformat", "Sffjs,Format,String.format,String.__Format,Number.prototype.format,Number.prototype.__Format,Date.prototype.format,Date.prototype.__Format" },
+};
+
+// Installs configurable accessor properties for each of the symbols, which load the module on first get or set. Before loading, all of the module's
+// stubs which haven't been replaced by a script are removed, so the module defines its symbols just like it would have when loaded at startup.
+static const char g_libraryModuleStubsScript[] = R"JS(
+(function(load, modules) {
+	"use strict";
+	for (const name in modules) {
+		const stubs = [];
+		const getters = new Set();
+		let loaded = false;
+		const loadModule = function() {
+			if (loaded)
+				return;
+			loaded = true;
+			for (const [obj, prop] of stubs) {
+				const d = Object.getOwnPropertyDescriptor(obj, prop);
+				if (d && getters.has(d.get))
+					delete obj[prop];
+			}
+			load(name);
+		};
+		for (const path of modules[name]) {
+			const parts = path.split('.');
+			const prop = parts.pop();
+			const obj = parts.reduce((o, p) => o[p], globalThis);
+			const get = function() { loadModule(); return Reflect.get(obj, prop, this); };
+			getters.add(get);
+			stubs.push([obj, prop]);
+			Object.defineProperty(obj, prop, {
+				configurable: true,
+				get: get,
+				set: function(v) { loadModule(); Reflect.set(obj, prop, v, this); },
+			});
+		}
+	}
+}))JS";
+
+void ScriptEngine::installLibraryModuleStubs()
+{
+	QJSValue modules = se->newObject();
+	for (const auto &mod : g_lazyLibraryModules) {
+		const QStringList symbols = QString::fromLatin1(mod.symbols).split(',');
+		QJSValue arr = se->newArray(symbols.size());
+		for (int i = 0; i < symbols.size(); ++i)
+			arr.setProperty(i, symbols.at(i));
+		modules.setProperty(QLatin1String(mod.name), arr);
+	}
+	const QJSValue loader = se->newQObject(this).property(QStringLiteral("loadLibraryModule"));
+	const QJSValue res = se->evaluate(QLatin1String(g_libraryModuleStubsScript), QStringLiteral("libraryModuleStubs")).call({ loader, modules });
+	if (res.isError())
+		qCCritical(lcPlugin) << "Exception while installing library module stubs:" << res.toString();
+}
+
+void ScriptEngine::loadLibraryModule(const QString &name)
+{
+	// Called from the stubs, so m_mutex is already locked by whatever script is running.
+	const qint64 heapBefore = heapSize();
+	QElapsedTimer timer;
+	timer.start();
+	evalScript(QLatin1String(":/scripts/") + name + QLatin1String(".min.js"));
+	const qint64 elapsed = timer.nsecsElapsed();
+	{
+		QMutexLocker lock(&m_statsMutex);
+		m_libraryModuleStats.insert(name, { elapsed, heapSize() - heapBefore });
+	}
+	qCDebug(lcPlugin) << "Loaded library module" << name << "for" << m_name << "in" << elapsed / 1000 << "us";
+}
+
+qint64 ScriptEngine::heapSize() const
+{
+#if !SCRIPT_ENGINE_USE_QML
+	if (!se)
+		return 0;
+	const QV4::MemoryManager *mm = se->handle()->memoryManager;
+	return qint64(mm->getUsedMem() + mm->getLargeItemsMem());
+#else
+	return 0;  // the memory manager is only available through the private headers included for QJSEngine builds
+#endif
+}
+
+QVariantMap ScriptEngine::engineStatistics() const
+{
+	QMutexLocker lock(&m_statsMutex);
+	QVariantMap modules;
+	for (auto it = m_libraryModuleStats.cbegin(), en = m_libraryModuleStats.cend(); it != en; ++it) {
+		modules.insert(it.key(), QVariantMap {
+			{ QStringLiteral("loadTimeMs"),     it->loadTimeNs / 1.0e6 },
+			{ QStringLiteral("heapDeltaBytes"), it->heapDelta },
+		});
+	}
+	QVariantMap ret {
+		{ QStringLiteral("initTimeMs"),             m_initStats.initTimeNs / 1.0e6 },
+		{ QStringLiteral("heapBytesBeforeLibrary"), m_initStats.heapBeforeLibrary },
+		{ QStringLiteral("heapBytesAfterInit"),     m_initStats.heapAfterInit },
+		{ QStringLiteral("libraryModules"),         modules },
+		{ QStringLiteral("thread"),                 m_thread ? m_thread->objectName() : QString() },
+		{ QStringLiteral("sharedThread"),           !m_ownsThread },
+		{ QStringLiteral("shardIndex"),             m_shardIndex },
+		{ QStringLiteral("shardCount"),             m_isShared ? sharedShardCount() : 1 },
+	};
+	// the memory manager can only be queried from the engine's own thread
+	if (QThread::currentThread() == thread())
+		ret.insert(QStringLiteral("heapBytes"), heapSize());
+	return ret;
+}
+
+void ScriptEngine::setName(const QByteArray &name)
+{
+	QMutexLocker lock(&m_mutex);
+	m_name = name;
+	setObjectName(QLatin1String("ScriptEngine: ") + name);
+	if (m_thread && m_ownsThread)
+		m_thread->setObjectName(objectName());
+	if (!m_isShared)
+		dse->instanceName = m_name;
+}
+
+// Additional Shared engines. Each one is a complete Shared environment with its own copy of the library; script instances are assigned to
+// one by name, so the same instance always runs in the same engine. Created once at startup and only accessed from the main thread after that.
+
+namespace {
+
+struct SharedShards
+{
+	QVector<ScriptEngine *> engines;  // not including sharedInstance
+	std::atomic_int requestedCount {1};
+	std::atomic_int count {1};        // including sharedInstance
+	bool created = false;
+};
+Q_GLOBAL_STATIC(SharedShards, g_sharedShards)
+
+// FNV-1a, so that assignments don't depend on Qt's hash seed or version.
+inline quint32 shardHash(const QByteArray &name)
+{
+	quint32 h = 2166136261u;
+	for (const char c : name)
+		h = (h ^ quint8(c)) * 16777619u;
+	return h;
+}
+
+}  // namespace
+
+void ScriptEngine::setSharedShardCount(int count)
+{
+	count = qMax(1, count);
+	if (g_sharedShards->created && count != g_sharedShards->count)
+		qCInfo(lcPlugin) << "The new number of Shared engines," << count << ", will take effect after the plugin is restarted.";
+	g_sharedShards->requestedCount = count;
+}
+
+int ScriptEngine::sharedShardCount() { return g_sharedShards->count; }
+
+void ScriptEngine::createSharedShards()
+{
+	if (g_sharedShards->created || !sharedInstance)
+		return;
+	g_sharedShards->created = true;
+	for (int i = 1; i < g_sharedShards->requestedCount; ++i) {
+		ScriptEngine *se = new ScriptEngine(sharedInstance->name() + '#' + QByteArray::number(i), false, i, nullptr);
+		g_sharedShards->engines.append(se);
+		// Registered by name so engine actions and lists can address it like any other engine.
+		DSE::insert(se->name(), se);
+	}
+	g_sharedShards->count = g_sharedShards->engines.size() + 1;
+	if (!g_sharedShards->engines.isEmpty())
+		qCInfo(lcPlugin) << "Shared script instances are distributed across" << sharedShardCount() << "Shared engines.";
+}
+
+QVector<ScriptEngine *> ScriptEngine::sharedShards() { return g_sharedShards->engines; }
+
+void ScriptEngine::deleteSharedShards()
+{
+	g_sharedShards->count = 1;
+	for (ScriptEngine * const se : std::as_const(g_sharedShards->engines))
+		DSE::removeEngine(se->name());
+	qDeleteAll(g_sharedShards->engines);
+	g_sharedShards->engines.clear();
+}
+
+ScriptEngine *ScriptEngine::sharedInstanceFor(const QByteArray &instanceName)
+{
+	const QVector<ScriptEngine *> &shards = g_sharedShards->engines;
+	if (shards.isEmpty())
+		return sharedInstance;
+	const quint32 idx = shardHash(instanceName) % quint32(shards.size() + 1);
+	return idx ? shards.at(idx - 1) : sharedInstance;
+}
+
+// Spare private engines, which are initialized in their own threads and handed out by acquirePrivateEngine().
+
+#define ENGINE_POOL_NAME  "(pool)"
+
+namespace {
+
+struct EnginePool
+{
+	QMutex mutex;
+	QVector<ScriptEngine *> engines;
+	int size = 0;
+	bool refillQueued = false;
+	// statistics
+	std::atomic_uint hits {0};
+	std::atomic_uint misses {0};
+	std::atomic<qint64> lastLatencyNs {0};
+	std::atomic<qint64> maxLatencyNs {0};
+	std::atomic<qint64> totalLatencyNs {0};
+};
+Q_GLOBAL_STATIC(EnginePool, g_enginePool)
+
+void queueEnginePoolRefill()
+{
+	QMutexLocker lock(&g_enginePool->mutex);
+	if (g_enginePool->refillQueued || !Plugin::instance)
+		return;
+	g_enginePool->refillQueued = true;
+	QMetaObject::invokeMethod(Plugin::instance, &ScriptEngine::refillEnginePool, Qt::QueuedConnection);
+}
+
+}  // namespace
+
+ScriptEngine *ScriptEngine::acquirePrivateEngine(const QByteArray &name)
+{
+	QElapsedTimer timer;
+	timer.start();
+	ScriptEngine *se = nullptr;
+	{
+		QMutexLocker lock(&g_enginePool->mutex);
+		QVector<ScriptEngine *> &engines = g_enginePool->engines;
+		for (int i = 0; i < engines.size(); ++i) {
+			if (engines.at(i)->isReady()) {
+				se = engines.takeAt(i);
+				break;
+			}
+		}
+	}
+	const bool pooled = !!se;
+	if (pooled) {
+		se->setName(name);
+		++g_enginePool->hits;
+		queueEnginePoolRefill();
+	}
+	else {
+		se = new ScriptEngine(name);
+		++g_enginePool->misses;
+	}
+
+	const qint64 elapsed = timer.nsecsElapsed();
+	g_enginePool->lastLatencyNs = elapsed;
+	g_enginePool->totalLatencyNs += elapsed;
+	qint64 max = g_enginePool->maxLatencyNs;
+	while (elapsed > max && !g_enginePool->maxLatencyNs.compare_exchange_weak(max, elapsed))
+		;
+	qCDebug(lcPlugin) << "Acquired" << (pooled ? "pooled" : "new") << "engine for" << name << "in" << elapsed / 1000 << "us";
+	return se;
+}
+
+void ScriptEngine::setEnginePoolSize(int size)
+{
+	{
+		QMutexLocker lock(&g_enginePool->mutex);
+		g_enginePool->size = qMax(0, size);
+	}
+	queueEnginePoolRefill();
+}
+
+int ScriptEngine::enginePoolSize()
+{
+	QMutexLocker lock(&g_enginePool->mutex);
+	return g_enginePool->size;
+}
+
+void ScriptEngine::refillEnginePool()
+{
+	QMutexLocker lock(&g_enginePool->mutex);
+	g_enginePool->refillQueued = false;
+	if (!sharedInstance)
+		return;
+	QVector<ScriptEngine *> &engines = g_enginePool->engines;
+	while (engines.size() > g_enginePool->size)
+		delete engines.takeLast();
+	while (engines.size() < g_enginePool->size)
+		engines.append(new ScriptEngine(QByteArrayLiteral(ENGINE_POOL_NAME), true));
+}
+
+void ScriptEngine::clearEnginePool()
+{
+	QMutexLocker lock(&g_enginePool->mutex);
+	qDeleteAll(g_enginePool->engines);
+	g_enginePool->engines.clear();
+}
+
+void ScriptEngine::setThreadPoolSize(int size)
+{
+	if (size < 0)
+		size = QThread::idealThreadCount();
+	QMutexLocker lock(&g_threadPool->mutex);
+	g_threadPool->size = size;
+}
+
+int ScriptEngine::threadPoolSize()
+{
+	QMutexLocker lock(&g_threadPool->mutex);
+	return g_threadPool->size;
+}
+
+void ScriptEngine::shutdownThreadPool()
+{
+	QMutexLocker lock(&g_threadPool->mutex);
+	const QVector<QThread *> threads = g_threadPool->threads;
+	g_threadPool->threads.clear();
+	g_threadPool->engineCounts.clear();
+	lock.unlock();
+	for (QThread *thread : threads) {
+		thread->quit();
+		thread->wait(1000);
+		delete thread;
+	}
+}
+
+QVariantMap ScriptEngine::enginePoolStatistics()
+{
+	int size, available = 0;
+	{
+		QMutexLocker lock(&g_enginePool->mutex);
+		size = g_enginePool->size;
+		for (const ScriptEngine *se : qAsConst(g_enginePool->engines))
+			available += se->isReady();
+	}
+	QVariantList threadEngines;
+	int threadPoolSize;
+	{
+		QMutexLocker lock(&g_threadPool->mutex);
+		threadPoolSize = g_threadPool->size;
+		for (QThread *thread : qAsConst(g_threadPool->threads))
+			threadEngines.append(g_threadPool->engineCounts.value(thread));
+	}
+	const quint32 hits = g_enginePool->hits, misses = g_enginePool->misses;
+	return QVariantMap {
+		{ QStringLiteral("size"),             size },
+		{ QStringLiteral("available"),        available },
+		{ QStringLiteral("hits"),             hits },
+		{ QStringLiteral("misses"),           misses },
+		{ QStringLiteral("lastLatencyMs"),    g_enginePool->lastLatencyNs / 1.0e6 },
+		{ QStringLiteral("maxLatencyMs"),     g_enginePool->maxLatencyNs / 1.0e6 },
+		{ QStringLiteral("averageLatencyMs"), hits + misses ? g_enginePool->totalLatencyNs / 1.0e6 / (hits + misses) : 0.0 },
+		{ QStringLiteral("threadPoolSize"),   threadPoolSize },
+		{ QStringLiteral("threadEngines"),    threadEngines },
+	};
+}
+
 void ScriptEngine::connectNamedScriptInstance(DynamicScript *ds)
 {
 	tpapi->connectInstance(ds);
@@ -254,48 +1189,247 @@ void ScriptEngine::throwError(QJSValue::ErrorType type, const QString &msg) cons
 	return ret;                                                    \
 }
 
-QJSValue ScriptEngine::expressionValue(const QString &fromValue, const QByteArray &instName)
+QString ScriptEngine::substituteConnectorValue(const QString &expr, int value)
+{
+	if (value < 0)
+		return expr;
+	return QString(expr).replace(QLatin1String(CONNECTOR_VALUE_PLACEHOLDER), QString::number(value), Qt::CaseInsensitive);
+}
+
+QJSValue ScriptEngine::expressionError(const QJSValue &res, const QString &expr) const
 {
-	QMutexLocker lock(&m_mutex);
-	dse->instanceName = instName;
-	const QJSValue res = se->evaluate(fromValue);
-	//se->collectGarbage();
-	if (!res.isError())
-		return res;
 	QJSValue ret = se->newErrorObject(res.errorType(),
 		res.property("name").toString() + ": " +
-		tr("while evaluating the expression") + " '" + fromValue + "': " +
+		tr("while evaluating the expression") + " '" + expr + "': " +
 		res.property("message").toString()
 	);
 	ret.setProperty("cause", res);
 	return ret;
 }
 
-QJSValue ScriptEngine::scriptValue(const QString &fileName, const QString &expr, const QByteArray &instName)
+QJSValue ScriptEngine::expressionValue(const QString &fromValue, const QByteArray &instName)
 {
-	bool ok;
-	QString script = QString::fromUtf8(readFile(fileName, &ok));
-	if (!ok)
-		return se->newErrorObject(QJSValue::URIError, tr("Could not read script file '%1': %2").arg(fileName, script));
-	if (script.trimmed().isEmpty())
-		return se->newErrorObject(QJSValue::URIError, tr("Script file '%1' was empty.").arg(fileName));
-	if (!expr.isEmpty())
-		script += '\n' + expr;
-	//qCDebug(lcPlugin) << "File:" << fileName << "Contents:\n" << script;
 	QMutexLocker lock(&m_mutex);
 	dse->instanceName = instName;
-	QJSValue res = se->evaluate(script, fileName);
-	//se->collectGarbage();
+	const QJSValue fn = cachedExpressionFunction(m_expressionFunctions, fromValue, false);
+	QJSValue res;
+	EvaluationScope eval(this);
+	if (fn.isCallable()) {
+		res = fn.call();
+	}
+	else {
+		++m_exprCacheUncompiled;
+		res = se->evaluate(fromValue);
+	}
+	eval.finish(res);
 	if (!res.isError())
 		return res;
-	EE_RETURN_FILE_ERROR_OBJ(fileName, res, tr("while evaluating '%1'").arg(expr));
+	return expressionError(res, fromValue);
+}
+
+// Compiles an expression into a function which returns the expression's result. If `bindConnectorValue` is true, the function takes the connector value
+// as its only argument. Returns a null value if the expression can't be compiled this way (eg. it has multiple statements).
+QJSValue ScriptEngine::compileExpression(const QString &expr, bool bindConnectorValue) const
+{
+	QString body;
+	if (!prepareExpressionBody(expr, body, bindConnectorValue))
+		return QJSValue(QJSValue::NullValue);
+	// A trailing semicolon is fine for an expression statement but not inside the `return (...)` it gets wrapped in.
+	body = body.trimmed();
+	while (body.endsWith(';')) {
+		body.chop(1);
+		body = body.trimmed();
+	}
+	// These would mean something different as an expression than as a statement (eg. a block vs. an object literal).
+	if (body.isEmpty() || body.startsWith('{') || body.startsWith(QLatin1String("function")) || body.startsWith(QLatin1String("class")))
+		return QJSValue(QJSValue::NullValue);
+	// The Function constructor parses the body on its own, so it will fail unless it's a single complete expression.
+	QJSValueList args;
+	if (bindConnectorValue)
+		args << QJSValue(QLatin1String(CONNECTOR_VALUE_ARGUMENT));
+	args << QJSValue(QLatin1String("return (") + body + QLatin1String("\n);"));
+	const QJSValue fn = se->globalObject().property(QStringLiteral("Function")).callAsConstructor(args);
+	return fn.isCallable() ? fn : QJSValue(QJSValue::NullValue);
+}
+
+// Returns the compiled function for `expr` from `cache`, compiling and caching it first if needed. m_mutex must be locked.
+// The result is a null value if the expression can't be compiled or caching is disabled.
+QJSValue ScriptEngine::cachedExpressionFunction(ExpressionCache &cache, const QString &expr, bool bindConnectorValue)
+{
+	const int capacity = m_exprCacheCapacity;
+	if (cache.maxCost() != capacity)
+		cache.setMaxCost(capacity);
+	if (!capacity)
+		return QJSValue(QJSValue::NullValue);
+
+	if (const QJSValue *fn = cache.object(expr)) {
+		++m_exprCacheHits;
+		return *fn;
+	}
+	++m_exprCacheMisses;
+	QJSValue fn = compileExpression(expr, bindConnectorValue);
+	cache.insert(expr, new QJSValue(fn));
+	m_exprCacheSize = m_expressionFunctions.size() + m_connectorFunctions.size();
+	return fn;
+}
+
+QJSValue ScriptEngine::connectorExpressionValue(const QString &expr, int connectorValue, const QByteArray &instName)
+{
+	QMutexLocker lock(&m_mutex);
+	const QJSValue fn = cachedExpressionFunction(m_connectorFunctions, expr, true);
+	if (!fn.isCallable()) {
+		lock.unlock();
+		return expressionValue(substituteConnectorValue(expr, connectorValue), instName);
+	}
+
+	dse->instanceName = instName;
+	EvaluationScope eval(this);
+	QJSValue res = fn.call({ connectorValue });
+	eval.finish(res);
+	if (!res.isError())
+		return res;
+	return expressionError(res, substituteConnectorValue(expr, connectorValue));
+}
+
+void ScriptEngine::setExpressionCacheCapacity(int capacity)
+{
+	// Applied by the next evaluation since the caches can only be touched with m_mutex locked, which may already be held if this was called from a script.
+	m_exprCacheCapacity = qMax(0, capacity);
+}
+
+void ScriptEngine::resumeSuspendedTimers()
+{
+	if (ulib)
+		ulib->resumeSuspendedTimers();
+}
+
+QVariantMap ScriptEngine::statistics() const
+{
+	return QVariantMap {
+		{ QStringLiteral("engine"), engineStatistics() },
+		{ QStringLiteral("watchdog"), watchdogStatistics() },
+		{ QStringLiteral("gc"), gcStatistics() },
+		{ QStringLiteral("expressionCache"), QVariantMap {
+			{ QStringLiteral("hits"),       (quint32)m_exprCacheHits },
+			{ QStringLiteral("misses"),     (quint32)m_exprCacheMisses },
+			{ QStringLiteral("uncompiled"), (quint32)m_exprCacheUncompiled },
+			{ QStringLiteral("size"),       (int)m_exprCacheSize },
+			{ QStringLiteral("capacity"),   (int)m_exprCacheCapacity },
+		}},
+		{ QStringLiteral("scriptFiles"), scriptFileStatistics() },
+		{ QStringLiteral("enginePool"), enginePoolStatistics() },
+		{ QStringLiteral("repeats"), m_repeatScheduler->statistics() },
+		{ QStringLiteral("lanes"), laneStatistics() },
+		{ QStringLiteral("connectors"), tpapi->connectorStatistics() },
+	};
+}
+
+QVariantMap ScriptEngine::scriptFileStatistics() const
+{
+	QVariantMap ret;
+	QMutexLocker lock(&m_scriptFilesMutex);
+	for (auto it = m_scriptFiles.cbegin(), en = m_scriptFiles.cend(); it != en; ++it) {
+		ret.insert(it.key(), QVariantMap {
+			{ QStringLiteral("hits"),          it->hits },
+			{ QStringLiteral("reloads"),       it->reloads },
+			{ QStringLiteral("evalTimeMs"),    it->evalTimeNs / 1.0e6 },
+		});
+	}
+	return ret;
+}
+
+QJSValue ScriptEngine::scriptValue(const QString &fileName, const QString &expr, const QByteArray &instName, int connectorValue)
+{
+	// The file source is cached until the file watcher reports a change. The file body is evaluated once per file version (and engine reset),
+	// after which only the expression is evaluated. With no expression the whole file is evaluated every time, as it is the script being run.
+	QString script;
+	quint32 version = 0;
+	{
+		QMutexLocker lock(&m_scriptFilesMutex);
+		ScriptFileRecord &rec = m_scriptFiles[fileName];
+		if (rec.stale) {
+			bool ok;
+			const QString source = QString::fromUtf8(readFile(fileName, &ok));
+			if (!ok || source.trimmed().isEmpty()) {
+				m_scriptFiles.remove(fileName);
+				if (!ok)
+					return se->newErrorObject(QJSValue::URIError, tr("Could not read script file '%1': %2").arg(fileName, source));
+				return se->newErrorObject(QJSValue::URIError, tr("Script file '%1' was empty.").arg(fileName));
+			}
+			if (rec.version)
+				++rec.reloads;
+			++rec.version;
+			rec.source = source;
+			rec.stale = false;
+			watchScriptFile(fileName);
+		}
+		else {
+			++rec.hits;
+		}
+		if (expr.isEmpty() || rec.evaluatedVersion != rec.version) {
+			script = rec.source;
+			version = rec.version;
+		}
+	}
+
+	if (!script.isEmpty()) {
+		//qCDebug(lcPlugin) << "File:" << fileName << "Contents:\n" << script;
+		QMutexLocker lock(&m_mutex);
+		dse->instanceName = instName;
+		QElapsedTimer timer;
+		timer.start();
+		EvaluationScope eval(this);
+		QJSValue res = se->evaluate(script, fileName);
+		eval.finish(res);
+		const qint64 elapsed = timer.nsecsElapsed();
+		{
+			QMutexLocker flock(&m_scriptFilesMutex);
+			const auto rec = m_scriptFiles.find(fileName);
+			if (rec != m_scriptFiles.end()) {
+				rec->evalTimeNs += elapsed;
+				// if evaluation failed the file body will be evaluated again next time
+				if (!res.isError() && rec->version == version)
+					rec->evaluatedVersion = version;
+			}
+		}
+		if (res.isError())
+			EE_RETURN_FILE_ERROR_OBJ(fileName, res, tr("while evaluating '%1'").arg(expr));
+		if (expr.isEmpty())
+			return res;
+	}
+	return connectorValue > -1 ? connectorExpressionValue(expr, connectorValue, instName) : expressionValue(expr, instName);
+}
+
+void ScriptEngine::watchScriptFile(const QString &fileName)
+{
+	// Created on first use so that it lives in the engine's thread.
+	if (!m_fileWatcher) {
+		m_fileWatcher = new QFileSystemWatcher();
+		connect(m_fileWatcher, &QFileSystemWatcher::fileChanged, this, &ScriptEngine::onScriptFileChanged);
+	}
+	// Files which are replaced on save (instead of modified in place) stop being watched, so they need to be added again.
+	if (!m_fileWatcher->files().contains(fileName))
+		m_fileWatcher->addPath(fileName);
+}
+
+void ScriptEngine::onScriptFileChanged(const QString &fileName)
+{
+	QMutexLocker lock(&m_scriptFilesMutex);
+	const auto rec = m_scriptFiles.find(fileName);
+	if (rec != m_scriptFiles.end()) {
+		rec->stale = true;
+		rec->source.clear();
+	}
+	qCDebug(lcPlugin) << "Script file changed:" << fileName << "for engine" << m_name;
 }
 
-QJSValue ScriptEngine::moduleValue(const QString &fileName, const QString &alias, const QString &expr, const QByteArray &instName)
+QJSValue ScriptEngine::moduleValue(const QString &fileName, const QString &alias, const QString &expr, const QByteArray &instName, int connectorValue)
 {
 	QMutexLocker lock(&m_mutex);
 	dse->instanceName = instName;
+	EvaluationScope eval(this);
 	QJSValue mod = se->importModule(fileName);
+	eval.finish(mod);
 	if (mod.isError()) {
 		EE_RETURN_FILE_ERROR_OBJ(fileName, mod, tr("while importing module"));
 	}
@@ -305,8 +1439,9 @@ QJSValue ScriptEngine::moduleValue(const QString &fileName, const QString &alias
 	}
 	globalObject().setProperty(alias, mod);
 	lock.unlock();
-	//se->collectGarbage();
-	return expr.isEmpty() ? QJSValue(QJSValue::UndefinedValue) : expressionValue(expr, instName);
+	if (expr.isEmpty())
+		return QJSValue(QJSValue::UndefinedValue);
+	return connectorValue > -1 ? connectorExpressionValue(expr, connectorValue, instName) : expressionValue(expr, instName);
 }
 
 bool ScriptEngine::timerExpression(const ScriptLib::TimerData *timData)
@@ -316,6 +1451,7 @@ bool ScriptEngine::timerExpression(const ScriptLib::TimerData *timData)
 	{
 		QMutexLocker lock(&m_mutex);
 		Utils::AutoResetString ars(dse->instanceName, timData->instanceName);
+		EvaluationScope eval(this);
 		QJSManagedValue m(timData->expression, se);
 		if (m.isFunction()) {
 			if (timData->thisObject.isObject())
@@ -329,6 +1465,7 @@ bool ScriptEngine::timerExpression(const ScriptLib::TimerData *timData)
 			res = se->evaluate(m.toString());
 		else
 			ok = false;
+		eval.finish(res);
 	}
 
 	//qCDebug(lcPlugin) << this << "TimerEvent:" << Util::TimerData::toString(timerType, timerId) << instName << "invalid?" << remove << "error?" << res.isError()
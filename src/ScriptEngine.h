@@ -31,7 +31,10 @@ to any 3rd-party components used within.
 	#include <QJSEngine>
 #endif
 
+#include <QCache>
+#include <QEvent>
 #include <QFile>
+#include <QHash>
 #include <QJsonDocument>
 #include <QJSValue>
 #include <QJSValueIterator>
@@ -39,6 +42,10 @@ to any 3rd-party components used within.
 #include <QNetworkAccessManager>
 #include <QObject>
 #include <QThread>
+#include <QVariantMap>
+
+#include <atomic>
+#include <functional>
 
 #include "common.h"
 #include "DSE.h"
@@ -83,6 +90,9 @@ class NetworkAccessManagerFactory : public QQmlNetworkAccessManagerFactory
 #endif
 
 class DynamicScript;
+class QFileSystemWatcher;
+class RepeatScheduler;
+class LaneEvent;
 
 namespace ScriptLib {
 	class TPAPI;
@@ -97,9 +107,66 @@ class ScriptEngine : public QObject
 		static ScriptEngine *sharedInstance;
 		static ScriptEngine *instance() { return sharedInstance; }
 
-		explicit ScriptEngine(const QByteArray &instanceName = QByteArray(), QObject *p = nullptr);
+		// If `initInThread` is true then the JS environment is initialized asynchronously in the engine's own thread, see isReady().
+		explicit ScriptEngine(const QByteArray &instanceName = QByteArray(), bool initInThread = false, QObject *p = nullptr)
+		  : ScriptEngine(instanceName, initInThread, 0, p) {}
 		~ScriptEngine();
 
+		// Sets the number of Shared engines which "Shared" scope script instances are distributed across, by a hash of the instance name.
+		// Only takes effect when createSharedShards() is called at startup. The default of 1 means all instances use the one sharedInstance.
+		static void setSharedShardCount(int count);
+		// Number of Shared engines actually in use, including sharedInstance.
+		static int sharedShardCount();
+		// Creates the additional Shared engines, if any; must be called once from the main (Plugin) thread after sharedInstance is created.
+		// They are also added to DSE::engines() under their "Shared#N" names, but are still owned here.
+		static void createSharedShards();
+		// Returns the additional Shared engines (not including sharedInstance).
+		static QVector<ScriptEngine *> sharedShards();
+		// Removes the additional Shared engines from DSE::engines() and deletes them, eg. at shutdown.
+		static void deleteSharedShards();
+		// Returns the Shared engine which the Shared scope script instance with given name should use. Always the same for any given name.
+		static ScriptEngine *sharedInstanceFor(const QByteArray &instanceName);
+
+		// Returns a new private engine with given `name`, taken from the pool of pre-initialized engines if one is available, or created on the spot.
+		// The pool is refilled in the background. Must be called from the main (Plugin) thread.
+		static ScriptEngine *acquirePrivateEngine(const QByteArray &name);
+		// Sets the number of spare private engines to keep initialized and ready for use; 0 disables the pool.
+		static void setEnginePoolSize(int size);
+		static int enginePoolSize();
+		// Creates or removes spare engines to match the pool size. Does nothing until the Shared engine exists.
+		static void refillEnginePool();
+		// Deletes all spare engines, eg. at shutdown.
+		static void clearEnginePool();
+		// Returns pool size and engine acquisition statistics. Safe to call from any thread.
+		static QVariantMap enginePoolStatistics();
+		// Sets the number of worker threads which Private engines created from now on are distributed across; 0 gives each engine its own thread,
+		// and a negative value uses the number of CPU cores. Engines keep their thread for life. The Shared engine always has its own thread.
+		static void setThreadPoolSize(int size);
+		static int threadPoolSize();
+		// Stops all worker threads; must be called after all Private engines have been deleted, eg. at shutdown.
+		static void shutdownThreadPool();
+
+		// Maximum time, in milliseconds, any single evaluation may run before the watchdog interrupts it; 0 disables the limit.
+		static void setEvaluationTimeLimit(int ms);
+		static int evaluationTimeLimit();
+		// Interrupts evaluations in all engines which have exceeded the time limit. Must be called periodically from a thread other than the engines'.
+		static void checkEvaluationTimeouts();
+		// Plugin-wide count of interrupted evaluations and the longest evaluation duration seen, in milliseconds.
+		static quint32 evaluationTimeoutCount();
+		static double evaluationMaxDurationMs();
+
+		// Garbage collection runs in the engine's thread once it has been idle for `gcIdleDelay()` ms after an evaluation (0 disables),
+		// or sooner if the heap grows past `gcHeapBudget()` bytes (0 disables).
+		inline int gcIdleDelay() const { return m_gcIdleDelayMs; }
+		inline void setGcIdleDelay(int ms) { m_gcIdleDelayMs = qMax(0, ms); }
+		inline qint64 gcHeapBudget() const { return m_gcHeapBudget; }
+		inline void setGcHeapBudget(qint64 bytes) { m_gcHeapBudget = qMax(Q_INT64_C(0), bytes); }
+		// Queues garbage collection in all engines which are due for it. Must be called periodically, typically from the same timer as checkEvaluationTimeouts().
+		static void scheduleGarbageCollection();
+		// Plugin-wide total of the last known heap sizes of all engines, and number of garbage collections run by the scheduler.
+		static qint64 totalHeapSize();
+		static quint32 garbageCollectionCount();
+
 		inline QJSEngine *engine() const { return se; }
 		inline QJSValue globalObject() const { return se ? se->globalObject() : QJSValue(); }
 		inline QJSValue registeredModules() const { return globalObject().property("registeredModules"); }
@@ -107,8 +174,36 @@ class ScriptEngine : public QObject
 		inline bool isSharedInstance() const { return m_isShared; }
 		inline DseNS::EngineInstanceType instanceType() const { return m_isShared ? DseNS::EngineInstanceType::SharedInstance : DseNS::EngineInstanceType::PrivateInstance; }
 		inline QByteArray name() const { return m_name; }
+		// True once the JS environment has been fully initialized.
+		inline bool isReady() const { return m_ready; }
 		inline QByteArray currentInstanceName() const { return dse->instanceName; }
 		inline ScriptLib::TPAPI *tpApiObject() const { return tpapi; }
+		// Returns `expr` with all occurrences of the "${connector_value}" placeholder replaced by `value`, or the original `expr` if `value` < 0.
+		static QString substituteConnectorValue(const QString &expr, int value);
+
+		// Maximum number of compiled expressions kept in each of the LRU caches; 0 disables caching.
+		inline int expressionCacheCapacity() const { return m_exprCacheCapacity; }
+		void setExpressionCacheCapacity(int capacity);
+		// Returns performance counters for this engine instance, grouped by subsystem. Safe to call from any thread.
+		QVariantMap statistics() const;
+		// Work for an engine's thread is dispatched in "lanes" by priority: input from Touch Portal actions and connectors first,
+		// then script timers, then background maintenance like garbage collection. The wait time in each lane is measured for statistics().
+		enum EventLane : quint8 { InputLane, TimerLane, BackgroundLane, EventLaneCount };
+		// Posts an event to `receiver`, which must live in this engine's thread, to run `func` with the priority of `lane`. The receiver's
+		// event() handler must pass it to dispatchLaneEvent(). The event is discarded, without running `func`, if the receiver is deleted first.
+		void postLaneEvent(QObject *receiver, EventLane lane, std::function<void()> &&func);
+		// Runs a posted lane event and returns true, or returns false if `ev` is some other event.
+		static bool dispatchLaneEvent(QEvent *ev);
+		// True while Input lane events are waiting. Long-running work in other lanes should yield to them.
+		inline bool inputPending() const { return m_pendingInput > 0; }
+		// Records how long work in `lane` waited to run, eg. a timer past its deadline.
+		void recordLaneWait(EventLane lane, qint64 waitNs);
+
+		// Re-queues script timers which were paused while their instance's pages were hidden, see DynamicScript::hiddenPageBehavior. Safe to call from any thread.
+		void resumeSuspendedTimers();
+		// Runs the held-button repeats of all script instances using this engine.
+		inline RepeatScheduler *repeatScheduler() const { return m_repeatScheduler; }
+
 		inline QNetworkAccessManager *networkAccessManager()
 		{
 			if (!m_nam)
@@ -142,8 +237,9 @@ class ScriptEngine : public QObject
 		//void onScriptResultReady(const QVariant &vres) { if (se) emit resultReady(se->toScriptValue(vres)); }
 
 		QJSValue expressionValue(const QString &fromValue, const QByteArray &instName = QByteArray());
-		QJSValue scriptValue(const QString &fileName, const QString &expr, const QByteArray &instName = QByteArray());
-		QJSValue moduleValue(const QString &fileName, const QString &alias, const QString &expr, const QByteArray &instName = QByteArray());
+		QJSValue scriptValue(const QString &fileName, const QString &expr, const QByteArray &instName = QByteArray(), int connectorValue = -1);
+		QJSValue moduleValue(const QString &fileName, const QString &alias, const QString &expr, const QByteArray &instName = QByteArray(), int connectorValue = -1);
+		QJSValue connectorExpressionValue(const QString &expr, int connectorValue, const QByteArray &instName = QByteArray());
 		bool timerExpression(const ScriptLib::TimerData *timData);
 		void include(const QString &file) const;
 		QJSValue require(const QString &file) const;
@@ -157,21 +253,116 @@ class ScriptEngine : public QObject
 
 		static void checkErrors(ScriptEngine *se) { if (se) se->checkErrors(); }
 
+	protected:
+		bool event(QEvent *ev) override;
+
 	private:
+		// A `shardIndex` > 0 creates an additional Shared engine, see createSharedShards().
+		ScriptEngine(const QByteArray &instanceName, bool initInThread, int shardIndex, QObject *p);
+
 		SCRIPT_ENGINE_BASE_TYPE *se = nullptr;
 		DSE *dse = nullptr;
 		ScriptLib::TPAPI *tpapi = nullptr;
 		ScriptLib::Util *ulib = nullptr;
+		RepeatScheduler *m_repeatScheduler = nullptr;
 		QThread *m_thread = nullptr;
 		QByteArray m_name;
 		bool m_isShared = false;
+		int m_shardIndex = 0;      // index of a Shared engine, 0 for sharedInstance and Private engines
+		bool m_ownsThread = true;  // false if m_thread is a pool worker shared with other engines
+		std::atomic_bool m_ready {false};
 		QMutex m_mutex;
 		QNetworkAccessManager *m_nam = nullptr;
+		// Expressions compiled into functions, keyed by expression text. The connector cache holds functions taking the connector value as argument.
+		// A null value means the expression could not be compiled this way and will be evaluated as-is (or with the connector value substituted as text).
+		using ExpressionCache = QCache<QString, QJSValue>;
+		ExpressionCache m_expressionFunctions;
+		ExpressionCache m_connectorFunctions;
+		std::atomic_int m_exprCacheCapacity;
+		std::atomic_int m_exprCacheSize {0};
+		std::atomic_uint m_exprCacheHits {0};
+		std::atomic_uint m_exprCacheMisses {0};
+		std::atomic_uint m_exprCacheUncompiled {0};
+		// Script file sources loaded by scriptValue(), keyed by file name. Guarded by m_scriptFilesMutex, which is never held while running scripts.
+		struct ScriptFileRecord {
+			QString source;
+			quint32 version = 0;           // incremented each time the file is (re)loaded
+			quint32 evaluatedVersion = 0;  // version of the file body last evaluated in the current engine, 0 if none
+			bool stale = true;
+			quint32 hits = 0;              // evaluations which used the cached source
+			quint32 reloads = 0;           // times the file was read again after a change
+			qint64 evalTimeNs = 0;         // total time spent evaluating the file body
+		};
+		// Evaluation watchdog state, guarded by m_watchdogMutex.
+		class EvaluationScope;
+		qint64 m_evalStartNs = 0;  // monotonic start time of the current evaluation, 0 when idle
+		bool m_evalInterrupted = false;
+		QMutex m_watchdogMutex;
+		std::atomic_uint m_evalTimeouts {0};
+		std::atomic<qint64> m_evalMaxNs {0};
+		std::atomic<qint64> m_evalLastNs {0};
+
+		// Garbage collection scheduling and statistics.
+		std::atomic_int m_gcIdleDelayMs;
+		std::atomic<qint64> m_gcHeapBudget;
+		std::atomic<qint64> m_lastActivityNs {0};
+		std::atomic<qint64> m_heapBytes {0};        // as of the end of the last evaluation or collection
+		std::atomic<qint64> m_heapAfterGc {0};
+		std::atomic_bool m_gcDirty {false};         // evaluations happened since the last collection
+		std::atomic_bool m_gcQueued {false};
+		std::atomic_uint m_gcCount {0};
+		std::atomic<qint64> m_gcLastPauseNs {0};
+		std::atomic<qint64> m_gcMaxPauseNs {0};
+		std::atomic<qint64> m_gcTotalPauseNs {0};
+
+		// Event lane wait statistics, only updated in the engine's thread.
+		struct LaneStatistics {
+			std::atomic_uint events {0};
+			std::atomic<qint64> lastWaitNs {0};
+			std::atomic<qint64> maxWaitNs {0};
+			std::atomic<qint64> totalWaitNs {0};
+		};
+		LaneStatistics m_laneStats[EventLaneCount];
+		std::atomic_int m_pendingInput {0};
+
+		// Initialization and library module statistics, guarded by m_statsMutex.
+		struct InitStatistics {
+			qint64 initTimeNs = 0;
+			qint64 heapBeforeLibrary = 0;  // JS heap size before evaluating the core library
+			qint64 heapAfterInit = 0;
+		};
+		struct LibraryModuleStatistics {
+			qint64 loadTimeNs;
+			qint64 heapDelta;
+		};
+		InitStatistics m_initStats;
+		QHash<QString, LibraryModuleStatistics> m_libraryModuleStats;
+		mutable QMutex m_statsMutex;
+		QHash<QString, ScriptFileRecord> m_scriptFiles;
+		mutable QMutex m_scriptFilesMutex;
+		QFileSystemWatcher *m_fileWatcher = nullptr;
 #if SCRIPT_ENGINE_USE_QML
 		NetworkAccessManagerFactory m_factory;
 #endif
 
 		void initScriptEngine();
+		void setName(const QByteArray &name);
+		void beginEvaluation();
+		bool endEvaluation();
+		QVariantMap watchdogStatistics() const;
+		void collectIdleGarbage();
+		QVariantMap gcStatistics() const;
+		QVariantMap laneStatistics() const;
+		void installLibraryModuleStubs();
+		Q_INVOKABLE void loadLibraryModule(const QString &name);
+		qint64 heapSize() const;  // 0 in SCRIPT_ENGINE_USE_QML builds
+		QVariantMap engineStatistics() const;
+		QJSValue compileExpression(const QString &expr, bool bindConnectorValue) const;
+		QJSValue cachedExpressionFunction(ExpressionCache &cache, const QString &expr, bool bindConnectorValue);
+		QJSValue expressionError(const QJSValue &res, const QString &expr) const;
+		void watchScriptFile(const QString &fileName);
+		void onScriptFileChanged(const QString &fileName);
+		QVariantMap scriptFileStatistics() const;
 		bool resolveFilePath(const QString &fileName, QString &resolvedFile) const;
 
 		void evalScript(const QString &fn) const
@@ -218,6 +409,7 @@ class ScriptEngine : public QObject
 			return jsDoc;
 		}
 
+		friend class LaneEvent;
 		Q_DISABLE_COPY(ScriptEngine)
 
 };
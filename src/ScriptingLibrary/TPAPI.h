@@ -49,7 +49,7 @@ class TPAPI : public QObject
 		  QObject(p), se(se)
 		{
 			setObjectName("DSE.TPAPI");
-			connect(ConnectorData::instance(), &ConnectorData::connectorsUpdated, this, &TPAPI::connectorIdsChanged);
+			connect(ConnectorData::instance(), &ConnectorData::connectorsUpdated, this, &TPAPI::onConnectorsUpdated);
 		}
 
 		~TPAPI()
@@ -94,6 +94,8 @@ class TPAPI : public QObject
 			connect(plugin, &Plugin::tpMessageEvent, this, &TPAPI::messageEvent, ctype);
 		}
 
+		QVariantMap connectorStatistics() { return connectorData()->statistics(); }
+
 		Q_INVOKABLE ConnectorRecord getConnectorByShortId(QJSValue shortId)
 		{
 			if (!shortId.isString() || shortId.toString().isEmpty()) {
@@ -207,6 +209,14 @@ class TPAPI : public QObject
 			se->checkErrors();
 		}
 
+	private Q_SLOTS:
+		// Updates arrive in batches, one queued call per engine, and are reported to scripts individually.
+		void onConnectorsUpdated(const QByteArrayList &instanceNames, const QByteArrayList &shortIds)
+		{
+			for (qsizetype i = 0, e = qMin(instanceNames.size(), shortIds.size()); i < e; ++i)
+				Q_EMIT connectorIdsChanged(instanceNames.at(i), shortIds.at(i));
+		}
+
 	private:
 		Q_SIGNAL void stateValueUpdate(const QByteArray &);
 		Q_SIGNAL void stateValueUpdateByName(const QByteArray &, const QByteArray &);
@@ -217,9 +227,10 @@ class TPAPI : public QObject
 		{
 			if (connData)
 				return connData;
-			if (se->isSharedInstance())
+			if (se == ScriptEngine::instance())
 				return ConnectorData::instance();
-			connData = new ConnectorData(se->currentInstanceName() /*, this*/);
+			// other engines get their own view of the shared data for separate statistics; Shared ones are named after the engine since the current instance name changes
+			connData = new ConnectorData(se->isSharedInstance() ? se->name() : se->currentInstanceName() /*, this*/);
 			return connData;
 		}
 
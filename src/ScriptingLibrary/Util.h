@@ -27,16 +27,25 @@ to any 3rd-party components used within.
 #include <QHash>
 #include <QJSValue>
 #include <QMetaEnum>
+#include <QMutex>
 #include <QObject>
 #include <QPointer>
 #include <QProcessEnvironment>
 #include <QReadWriteLock>
+#include <QSet>
 #include <QUrl>
 #include <QTimer>
 #include <QThread>
 
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
 #include "common.h"
 #include "utils.h"
+#include "DynamicScript.h"
 #include "ScriptEngine.h"
 
 #ifndef DOXYGEN
@@ -46,7 +55,6 @@ namespace ScriptLib {
 struct TimerData
 {
 	enum TimerType : quint8 { NoneType, SingleShot, Repeating };
-	using timPtr_t = QSharedPointer<QTimer>;
 
 	int id;
 	TimerType type = TimerType::NoneType;
@@ -54,7 +62,6 @@ struct TimerData
 	QJSValue thisObject;
 	QJSValueList args;
 	int interval;
-	timPtr_t tim = nullptr;
 	QByteArray instanceName;
 
 	QString toString() const { return toString(type, id); }
@@ -86,93 +93,220 @@ class Util : public QObject
 
 	private:
 
+		// Timer events waiting in the queue, ordered by deadline and then by ID so that timers due at the same time run in the order they were started.
+		struct TimerEvent {
+			qint64 deadline;
+			int id;
+			bool operator>(const TimerEvent &other) const { return deadline > other.deadline || (deadline == other.deadline && id > other.id); }
+		};
+
 		ScriptEngine *se = nullptr;
-		QReadWriteLock m_timersMutex;
+		QMutex m_timersMutex;
 		std::atomic_int m_nextTimerId = 0;
-		QHash<int, TimerData> m_timers;
+		// All script timers of this engine run from one queue and one native timer, armed for the earliest deadline.
+		// The timer data is stored only here; the node-based map keeps each item in place while its expression runs, even if other timers are added or removed.
+		std::unordered_map<int, TimerData> m_timers;
+		QHash<QByteArray, QSet<int>> m_instanceTimers;  // timer IDs by instance name
+		std::vector<TimerEvent> m_timerQueue;            // min-heap, capacity is kept when timers are cleared
+		int m_staleTimerEvents = 0;                      // queued events of timers which were cleared before running
+		QSet<int> m_suspendedTimers;                     // timers paused while their instance is hidden, these have no queued event
+		int m_runningTimerId = 0;
+		bool m_runningTimerCleared = false;
+		bool m_processingTimers = false;
+		bool m_armQueued = false;
+		qint64 m_armedDeadline = -1;
+		QTimer *m_queueTimer = nullptr;
 
 		// Timers implementation
 
+		// Minimum interval of repeating timers with DseNS::ThrottleWhenHidden.
+		static constexpr int HIDDEN_PAGE_THROTTLE_MS = 1000;
+
+		static inline qint64 nowNs() { return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count(); }
+
 		int startScriptTimer(TimerData::TimerType type, QJSValue expression, int delay, const QJSValueList &args = QJSValueList())
 		{
 			if (!se || !(expression.isString() || expression.isCallable() || (expression.isArray() && expression.property("length").toInt() > 0)))
 				return -1;
-			int timerId = ++m_nextTimerId;
-			QWriteLocker l(&m_timersMutex);
-			QTimer *tim = nullptr;
-			if (delay > 0) {
-				tim = new QTimer();
-				tim->setSingleShot(true);
-				tim->setTimerType(Qt::PreciseTimer);
-				tim->setInterval(delay);
-				connect(tim, &QTimer::timeout, this, [=]() { execTimer(timerId); }, Qt::DirectConnection);
-				connect(this, &Util::killTimers, tim, &QTimer::stop, Qt::QueuedConnection);
-			}
 			QJSValue thisObject;
 			if (expression.isArray()) {
 				if (expression.property("length").toInt() > 1)
 					thisObject = expression.property(1);
 				expression = expression.property(0);
 			}
-			const TimerData td = m_timers.insert(timerId,
-			{
-				timerId,
-				type,
-				expression,
-				thisObject,
-				args,
-				delay,
-				(tim ? TimerData::timPtr_t(tim, &QObject::deleteLater) : nullptr),
-				se->currentInstanceName()
-			}).value();
-			//qCDebug(lcPlugin) << this << "TimerEvent: Created timer" << timerId << type << "itvl:" << delay << "for instance" << td.instanceName << "on thread" << QThread::currentThread() << "(app" << qApp->thread() << ')';
-			timerStart(td);
+			const int timerId = ++m_nextTimerId;
+			const QByteArray instanceName = se->currentInstanceName();
+			QMutexLocker l(&m_timersMutex);
+			m_timers.emplace(timerId, TimerData { timerId, type, expression, thisObject, args, delay, instanceName });
+			m_instanceTimers[instanceName].insert(timerId);
+			//qCDebug(lcPlugin) << this << "TimerEvent: Created timer" << timerId << type << "itvl:" << delay << "for instance" << instanceName << "on thread" << QThread::currentThread() << "(app" << qApp->thread() << ')';
+			queueTimer(timerId, delay);
 			return timerId;
 		}
 
-		void timerStart(const TimerData &td)
+		// m_timersMutex must be locked.
+		void queueTimer(int timerId, int delay)
 		{
-			if (td.interval > 0) {
-				if (td.tim)
-					td.tim->start();
+			const qint64 deadline = nowNs() + qMax(delay, 0) * 1000000LL;
+			m_timerQueue.push_back({ deadline, timerId });
+			std::push_heap(m_timerQueue.begin(), m_timerQueue.end(), std::greater<TimerEvent>());
+			// The native timer only needs to change if this is now the earliest deadline; processTimers() re-arms it when it's done anyway.
+			if (m_processingTimers || (m_armedDeadline > -1 && m_armedDeadline <= deadline))
+				return;
+			if (QThread::currentThread() == thread()) {
+				armTimer();
+			}
+			else if (!m_armQueued) {
+				m_armQueued = true;
+				QMetaObject::invokeMethod(this, [this]() {
+					QMutexLocker l(&m_timersMutex);
+					m_armQueued = false;
+					armTimer();
+				}, Qt::QueuedConnection);
+			}
+		}
+
+		// m_timersMutex must be locked and this must run in our thread.
+		void armTimer()
+		{
+			if (m_timerQueue.empty()) {
+				m_armedDeadline = -1;
+				m_queueTimer->stop();
+				return;
+			}
+			const qint64 deadline = m_timerQueue.front().deadline;
+			if (deadline == m_armedDeadline && m_queueTimer->isActive())
+				return;
+			m_armedDeadline = deadline;
+			const qint64 remain = deadline - nowNs();
+			// Round up so the timer never fires before the deadline.
+			m_queueTimer->start(remain > 0 ? int((remain + 999999) / 1000000) : 0);
+		}
+
+		// m_timersMutex must be locked.
+		void removeTimer(int timerId, bool updateIndex = true)
+		{
+			// The running timer is removed by processTimers() once its expression returns.
+			if (timerId == m_runningTimerId) {
+				m_runningTimerCleared = true;
+				return;
+			}
+			const auto it = m_timers.find(timerId);
+			if (it == m_timers.end())
+				return;
+			if (updateIndex)
+				removeFromInstanceIndex(it->second.instanceName, timerId);
+			m_timers.erase(it);
+			if (m_suspendedTimers.remove(timerId))
 				return;
+			// Its queued event is skipped when it comes up, unless there are so many cleared timers (eg. from debouncing) that it's worth purging them now.
+			if (++m_staleTimerEvents > 64 && m_staleTimerEvents > (int)m_timerQueue.size() / 2) {
+				m_timerQueue.erase(std::remove_if(m_timerQueue.begin(), m_timerQueue.end(), [this](const TimerEvent &ev) { return !m_timers.count(ev.id); }), m_timerQueue.end());
+				std::make_heap(m_timerQueue.begin(), m_timerQueue.end(), std::greater<TimerEvent>());
+				m_staleTimerEvents = 0;
 			}
-			QMetaObject::invokeMethod(this, "execTimer", Qt::QueuedConnection, Q_ARG(int, td.id));
+		}
+
+		void removeFromInstanceIndex(const QByteArray &instanceName, int timerId)
+		{
+			const auto it = m_instanceTimers.find(instanceName);
+			if (it == m_instanceTimers.end())
+				return;
+			it->remove(timerId);
+			if (it->isEmpty())
+				m_instanceTimers.erase(it);
 		}
 
 		void clearScriptTimer(int timerId)
 		{
-			QWriteLocker l(&m_timersMutex);
-			m_timers.remove(timerId);
-			//if (m_timers.remove(timerId))
-			//	qCDebug(lcPlugin) << this << "TimerEvent: Killed timer" << timerId << "thread" << QThread::currentThread() << "app" << qApp->thread();
+			QMutexLocker l(&m_timersMutex);
+			removeTimer(timerId);
+			//qCDebug(lcPlugin) << this << "TimerEvent: Killed timer" << timerId << "thread" << QThread::currentThread() << "app" << qApp->thread();
+		}
+
+		// Returns how timers of the named instance should run right now, depending on whether it's on the current page. Must be called with m_timersMutex unlocked.
+		static DseNS::HiddenPageBehavior instancePageBehavior(const QByteArray &instanceName)
+		{
+			QReadLocker l(DSE::instances_mutex());
+			const DynamicScript *ds = DSE::instances()->value(instanceName, nullptr);
+			return ds ? ds->currentPageBehavior() : DseNS::RunWhenHidden;
+		}
+
+		// Queues all paused timers to run now. The ones whose instance is still hidden are paused again when they come up.
+		void resumeSuspendedTimers()
+		{
+			QMutexLocker l(&m_timersMutex);
+			if (m_suspendedTimers.isEmpty())
+				return;
+			const QSet<int> ids = std::exchange(m_suspendedTimers, QSet<int>());
+			for (const int id : ids)
+				queueTimer(id, 0);
 		}
 
 	private Q_SLOTS:
-		void execTimer(int id)
+		void processTimers()
 		{
-			QReadLocker l(&m_timersMutex);
-			const TimerData td = m_timers.value(id);
-			l.unlock();
-			if (td.type == TimerData::NoneType) {
-				qCDebug(lcPlugin) << this << "TimerEvent: Expired ID" << id << "thread" << QThread::currentThread() << "app" << qApp->thread();
+			QMutexLocker l(&m_timersMutex);
+			m_armedDeadline = -1;
+			// A script may run a nested event loop; its timers will run once it returns.
+			if (m_processingTimers)
 				return;
+			m_processingTimers = true;
+			// Only run what was queued when we started, so that a zero-delay timer which keeps re-starting itself can't starve other events.
+			size_t count = m_timerQueue.size();
+			bool ranTimer = false;
+			qint64 now;
+			while (count-- && !m_timerQueue.empty() && m_timerQueue.front().deadline <= (now = nowNs())) {
+				// Button presses and other input waiting in the engine's thread go first; the timer is re-armed right away for the rest.
+				if (ranTimer && se->inputPending())
+					break;
+				std::pop_heap(m_timerQueue.begin(), m_timerQueue.end(), std::greater<TimerEvent>());
+				const TimerEvent ev = m_timerQueue.back();
+				const int id = ev.id;
+				m_timerQueue.pop_back();
+				const auto it = m_timers.find(id);
+				if (it == m_timers.end()) {
+					--m_staleTimerEvents;
+					continue;
+				}
+				se->recordLaneWait(ScriptEngine::TimerLane, now - ev.deadline);
+				ranTimer = true;
+
+				TimerData &td = it->second;
+				m_runningTimerId = id;
+				m_runningTimerCleared = false;
+				l.unlock();
+				const DseNS::HiddenPageBehavior pageBehavior = instancePageBehavior(td.instanceName);
+				const bool ok = pageBehavior == DseNS::PauseWhenHidden || se->timerExpression(&td);
+				l.relock();
+				m_runningTimerId = 0;
+
+				if (ok && !m_runningTimerCleared && pageBehavior == DseNS::PauseWhenHidden) {
+					m_suspendedTimers.insert(id);
+				}
+				else if (ok && !m_runningTimerCleared && td.type == TimerData::Repeating) {
+					queueTimer(id, pageBehavior == DseNS::ThrottleWhenHidden ? qMax(td.interval, HIDDEN_PAGE_THROTTLE_MS) : td.interval);
+				}
+				else {
+					removeFromInstanceIndex(td.instanceName, id);
+					m_timers.erase(id);
+				}
 			}
-
-			const bool ok = se->timerExpression(&td);
-			if (ok && td.type == TimerData::Repeating)
-				timerStart(td);
-			else
-				clearScriptTimer(id);
+			m_processingTimers = false;
+			armTimer();
 		}
 
 		// /end Timers
 
 	public:
 		explicit Util(ScriptEngine *se, QObject *p = nullptr) :
-		  QObject(p), se(se)
+		  QObject(p), se(se),
+		  m_queueTimer{new QTimer(this)}
 		{
 			setObjectName("DSE.Util");
+			m_queueTimer->setSingleShot(true);
+			m_queueTimer->setTimerType(Qt::PreciseTimer);
+			connect(m_queueTimer, &QTimer::timeout, this, &Util::processTimers);
 		}
 
 		~Util()
@@ -216,40 +350,38 @@ class Util : public QObject
 		// If invoked in a Private engine, affects only the timers for that particular named instance.
 		void clearAllTimers()
 		{
+			QMutexLocker l(&m_timersMutex);
 			if (m_timers.empty()) {
 				//qCDebug(lcPlugin) << this << "No timers were active.";
 				return;
 			}
-			Q_EMIT killTimers();
-			// give timers a chance to stop... ?
-			//if (QAbstractEventDispatcher *ed = thread()->eventDispatcher())
-			//	ed->processEvents(QEventLoop::AllEvents);
-			QWriteLocker l(&m_timersMutex);
+			// Keep the running timer's data in place until it returns.
+			auto running = m_timers.extract(m_runningTimerId);
 			m_timers.clear();
+			if (!running.empty()) {
+				m_timers.insert(std::move(running));
+				m_runningTimerCleared = true;
+			}
+			m_instanceTimers.clear();
+			// The native timer may still fire once, with nothing to do.
+			m_timerQueue.clear();
+			m_suspendedTimers.clear();
+			m_staleTimerEvents = 0;
 			qCDebug(lcPlugin) << this << "Cleared all timers";
 		}
 
 		// Cancel timer(s) for a given instance name.
 		void clearInstanceTimers(const QByteArray &name)
 		{
-			int count = 0;
-			QWriteLocker l(&m_timersMutex);
-			QMutableHashIterator it(m_timers);
-			while (it.hasNext()) {
-				if (it.next().value().instanceName == name) {
-					it.remove();
-					++count;
-				}
-			}
-			qCDebug(lcPlugin) << this << "Cleared" << count << "timer(s) for instance" << name;
+			QMutexLocker l(&m_timersMutex);
+			const QSet<int> ids = m_instanceTimers.take(name);
+			for (const int id : ids)
+				removeTimer(id, false);
+			qCDebug(lcPlugin) << this << "Cleared" << ids.size() << "timer(s) for instance" << name;
 		}
 
 		// \}
 
-	Q_SIGNALS:
-		// internal
-		void killTimers();
-
 	public:
 		// \name Environment variables;  Env.js uses these methods to provide the Env JS object in the engine.
 		// \{
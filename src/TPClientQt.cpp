@@ -18,15 +18,17 @@ of their respective licenses. The copyright notice above does not apply
 to any 3rd-party components used within.
 */
 
+#include <atomic>
+#include <cstring>
+
 #include <QElapsedTimer>
-#include <QMetaEnum>
+#include <QHash>
+#include <QSet>
 #include <QTcpSocket>
 #include <QThread>
+#include <QTimer>
+#include <QVector>
 #include <QDebug>
-#if TP_CLIENT_ENABLE_SEND_QUEUE
-#include <QCoreApplication>
-#include <QQueue>
-#endif
 
 #include "TPClientQt.h"
 
@@ -36,17 +38,257 @@ Q_LOGGING_CATEGORY(lcTPC, "TPClientQt", QtDebugMsg);
 Q_LOGGING_CATEGORY(lcTPC, "TPClientQt", QtWarningMsg);
 #endif
 
+// Minimal JSON writer used for fixed-shape messages; appends directly to a byte buffer.
+namespace {
+
+template <std::size_t N>
+inline void appendLiteral(QByteArray &out, const char (&lit)[N])
+{
+	out.append(lit, int(N - 1));
+}
+
+inline void appendUInt(QByteArray &out, uint value)
+{
+	char tmp[10];
+	int i = sizeof(tmp);
+	do {
+		tmp[--i] = char('0' + value % 10);
+		value /= 10;
+	} while (value);
+	out.append(tmp + i, int(sizeof(tmp)) - i);
+}
+
+// Appends `str` as a quoted and escaped JSON string. UTF-8 is passed through as-is; a null `str` is written as an empty string.
+void appendJsonString(QByteArray &out, const char *str)
+{
+	static const char hexDigits[] = "0123456789abcdef";
+	out.append('"');
+	if (str) {
+		const char *run = str, *p = str;
+		for (; *p; ++p) {
+			const uchar c = uchar(*p);
+			if (c >= 0x20 && c != '"' && c != '\\')
+				continue;
+			out.append(run, int(p - run));
+			run = p + 1;
+			switch (c) {
+				case '"':  appendLiteral(out, "\\\""); break;
+				case '\\': appendLiteral(out, "\\\\"); break;
+				case '\b': appendLiteral(out, "\\b"); break;
+				case '\f': appendLiteral(out, "\\f"); break;
+				case '\n': appendLiteral(out, "\\n"); break;
+				case '\r': appendLiteral(out, "\\r"); break;
+				case '\t': appendLiteral(out, "\\t"); break;
+				default: {
+					const char esc[6] = { '\\', 'u', '0', '0', hexDigits[c >> 4], hexDigits[c & 0xF] };
+					out.append(esc, 6);
+					break;
+				}
+			}
+		}
+		out.append(run, int(p - run));
+	}
+	out.append('"');
+}
+
+// Minimal JSON scanner for peeking at message properties w/out fully parsing them.
+
+inline const char *skipWhitespace(const char *p, const char *end)
+{
+	while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n'))
+		++p;
+	return p;
+}
+
+// `p` points at the opening quote; returns a pointer past the closing quote or nullptr if the string is not terminated.
+const char *skipString(const char *p, const char *end)
+{
+	for (++p; p < end; ++p) {
+		if (*p == '\\')
+			++p;
+		else if (*p == '"')
+			return p + 1;
+	}
+	return nullptr;
+}
+
+// Returns a pointer past the value starting at `p`, or nullptr on malformed input.
+const char *skipValue(const char *p, const char *end)
+{
+	if (*p == '"')
+		return skipString(p, end);
+	if (*p == '{' || *p == '[') {
+		int depth = 0;
+		while (p < end) {
+			switch (*p) {
+				case '"':
+					if (!(p = skipString(p, end)))
+						return nullptr;
+					continue;
+				case '{':
+				case '[':
+					++depth;
+					break;
+				case '}':
+				case ']':
+					if (--depth == 0)
+						return p + 1;
+					break;
+				default:
+					break;
+			}
+			++p;
+		}
+		return nullptr;
+	}
+	// number, bool, or null
+	while (p < end && *p != ',' && *p != '}' && *p != ']' && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n')
+		++p;
+	return p;
+}
+
+// Top-level members of a message found by peekMessage(). The arrays reference the scanned data.
+struct PeekedMessage {
+	QByteArray type;
+	QByteArray connectorId;
+	QByteArray pluginId;
+	QByteArray value;  // raw JSON number
+	QByteArray data;   // raw JSON array
+	bool hasOther = false;  // there are other members (or escaped strings) which only a full parse would reproduce
+};
+
+// Scans the top-level members of a JSON object for the raw values of the members above, without decoding anything.
+bool peekMessage(const char *p, const char *end, PeekedMessage &pm)
+{
+	p = skipWhitespace(p, end);
+	if (p == end || *p != '{')
+		return false;
+	p = skipWhitespace(p + 1, end);
+	if (p < end && *p == '}')
+		return true;
+	while (p < end) {
+		if (*p != '"')
+			return false;
+		const char *key = p + 1;
+		if (!(p = skipString(p, end)))
+			return false;
+		const int keyLen = int(p - 1 - key);
+		p = skipWhitespace(p, end);
+		if (p == end || *p != ':')
+			return false;
+		p = skipWhitespace(p + 1, end);
+		if (p == end)
+			return false;
+		const char *val = p;
+		if (!(p = skipValue(p, end)))
+			return false;
+		const int valLen = int(p - val);
+		if (*val == '"') {
+			QByteArray *out = nullptr;
+			if (keyLen == 4 && !memcmp(key, "type", 4))
+				out = &pm.type;
+			else if (keyLen == 11 && !memcmp(key, "connectorId", 11))
+				out = &pm.connectorId;
+			else if (keyLen == 8 && !memcmp(key, "pluginId", 8))
+				out = &pm.pluginId;
+			if (!out || memchr(val + 1, '\\', valLen - 2)) {
+				// Escaped type or ID values would need decoding, so leave those to the full parser.
+				if (out && out != &pm.pluginId)
+					return false;
+				pm.hasOther = true;
+			}
+			else {
+				*out = QByteArray::fromRawData(val + 1, valLen - 2);
+			}
+		}
+		else if (keyLen == 5 && !memcmp(key, "value", 5) && (*val == '-' || (*val >= '0' && *val <= '9'))) {
+			pm.value = QByteArray::fromRawData(val, valLen);
+		}
+		else if (keyLen == 4 && !memcmp(key, "data", 4) && *val == '[') {
+			pm.data = QByteArray::fromRawData(val, valLen);
+		}
+		else {
+			pm.hasOther = true;
+		}
+		p = skipWhitespace(p, end);
+		if (p == end)
+			return false;
+		if (*p == '}')
+			return true;
+		if (*p != ',')
+			return false;
+		p = skipWhitespace(p + 1, end);
+	}
+	return false;
+}
+
+// Builds a connectorChange message from its scanned members so that only the nested 'data' array needs to be parsed.
+// Returns false if the message has anything else in it, in which case it needs a full parse.
+bool buildConnectorChange(const PeekedMessage &pm, QJsonObject &msg)
+{
+	if (pm.hasOther || pm.connectorId.isEmpty() || pm.value.isEmpty() || pm.data.isEmpty())
+		return false;
+	bool ok;
+	const double value = QByteArray(pm.value.constData(), pm.value.size()).toDouble(&ok);
+	if (!ok)
+		return false;
+	const QJsonDocument data = QJsonDocument::fromJson(pm.data);
+	if (!data.isArray())
+		return false;
+	msg = QJsonObject {
+		{ QStringLiteral("type"), QStringLiteral("connectorChange") },
+		{ QStringLiteral("connectorId"), QString::fromUtf8(pm.connectorId) },
+		{ QStringLiteral("value"), value },
+		{ QStringLiteral("data"), data.array() },
+	};
+	if (!pm.pluginId.isNull())
+		msg.insert(QStringLiteral("pluginId"), QString::fromUtf8(pm.pluginId));
+	return true;
+}
+
+// Resolves a message type name to enum value by length and first character, then verifies the full name.
+TPClientQt::MessageType decodeMessageType(const char *name, int len)
+{
+	using MT = TPClientQt::MessageType;
+	const char *expect = nullptr;
+	MT type = MT::Unknown;
+	switch (len) {
+		case 2:  expect = "up"; type = MT::up; break;
+		case 4:
+			if (*name == 'i') { expect = "info"; type = MT::info; }
+			else { expect = "down"; type = MT::down; }
+			break;
+		case 6:  expect = "action"; type = MT::action; break;
+		case 8:  expect = "settings"; type = MT::settings; break;
+		case 9:  expect = "broadcast"; type = MT::broadcast; break;
+		case 10: expect = "listChange"; type = MT::listChange; break;
+		case 11: expect = "closePlugin"; type = MT::closePlugin; break;
+		case 15: expect = "connectorChange"; type = MT::connectorChange; break;
+		case 25: expect = "notificationOptionClicked"; type = MT::notificationOptionClicked; break;
+		case 28: expect = "shortConnectorIdNotification"; type = MT::shortConnectorIdNotification; break;
+		default:
+			return MT::Unknown;
+	}
+	return memcmp(name, expect, len) ? MT::Unknown : type;
+}
+
+}  // namespace
 
 struct TPClientQt::Private
 {
 	Private(TPClientQt *q, const char *pluginId) :
 	  q(q),
 	  socket(new QTcpSocket(q)),
+	  sendTimer(new QTimer(q)),
+	  writeTimer(new QTimer(q)),
 	  pluginId(pluginId)
 	{
-#if TP_CLIENT_ENABLE_SEND_QUEUE
+		sendTimer->setSingleShot(true);
+		writeTimer->setSingleShot(true);
+		writeTimer->setInterval(0);
 		messageQ.reserve(100);
-#endif
+		writeBuffer.reserve(writeThreshold);
+		encodeBuffer.reserve(512);
 	}
 
 	inline void onSockStateChanged(QAbstractSocket::SocketState s)
@@ -72,6 +314,9 @@ struct TPClientQt::Private
 				break;
 
 			case QAbstractSocket::UnconnectedState:
+				writeBuffer.resize(0);
+				// A partial line left over from this connection would corrupt the first message of the next one.
+				readBuffer.resize(0);
 				if (tpInfo.paired) {
 					tpInfo.paired = false;
 					qCInfo(lcTPC) << "Closed Touch Portal Connection.";
@@ -149,23 +394,86 @@ struct TPClientQt::Private
 		Q_EMIT q->message(type, msg);
 	}
 
-	void write(const QByteArray &data) const
+	// Appends the message and terminator to the write buffer and flushes it, or schedules a flush, according to the current policy.
+	void write(const QByteArray &data, bool deferFlush = false)
 	{
 		if (!socket || !socket->isWritable())
 			return;
-		const int len = data.length();
-		qint64 bw = 0, sbw = 0;
-		do {
-			sbw = socket->write(data);
-			bw += sbw;
+		writeBuffer.append(data).append('\n');
+		++statWritten;
+		if (deferFlush)
+			return;
+		if (flushPolicy == WriteFlushPolicy::LowLatency || writeBuffer.size() >= writeThreshold)
+			flushWriteBuffer();
+		else if (!writeTimer->isActive())
+			writeTimer->start();
+	}
+
+	void flushWriteBuffer()
+	{
+		writeTimer->stop();
+		if (writeBuffer.isEmpty())
+			return;
+		if (!socket->isWritable()) {
+			writeBuffer.resize(0);
+			return;
 		}
-		while (bw != len && sbw > -1);
-		if (sbw < 0) {
+		const qint64 bw = socket->write(writeBuffer);
+		// resize() rather than clear() to keep the reserved capacity for the next batch
+		writeBuffer.resize(0);
+		if (bw < 0) {
 			qCCritical(lcTPC()) << "Socket write error: " << socket->errorString();
 			q->disconnect();
 			return;
 		}
-		socket->write("\n", 1);
+		statBytes += bw;
+		++statSegments;
+	}
+
+	void enqueue(const QByteArray &data, const QByteArray &key = QByteArray())
+	{
+		++statQueued;
+		if (!key.isEmpty()) {
+			const auto idx = messageQIndex.constFind(key);
+			if (idx != messageQIndex.cend()) {
+				// latest value wins; the message keeps its original place in the queue
+				messageQ[idx.value()] = data;
+				++statMerged;
+				return;
+			}
+			messageQIndex.insert(key, messageQ.size());
+		}
+		else {
+			// Unkeyed messages are ordering barriers, nothing queued before them may be replaced by later updates.
+			messageQIndex.clear();
+		}
+		messageQ.append(data);
+		if (!sendTimer->isActive())
+			sendTimer->start(sendInterval);
+	}
+
+	// Sends the message in encodeBuffer, using `key` (if any) for send queue coalescing.
+	void sendEncoded(const char *key = nullptr)
+	{
+		// The queue gets its own exactly sized copy; sharing encodeBuffer would make the next encoder detach and allocate anyway.
+		if (enableSendQueue)
+			enqueue(QByteArray(encodeBuffer.constData(), encodeBuffer.size()), key ? QByteArray(key) : QByteArray());
+		else
+			write(encodeBuffer);
+	}
+
+	void flushQueue()
+	{
+		sendTimer->stop();
+		if (messageQ.isEmpty())
+			return;
+		// Swap out the queue first in case write() fails and disconnects, which flushes again.
+		flushQ.swap(messageQ);
+		messageQIndex.clear();
+		for (const QByteArray &msg : qAsConst(flushQ))
+			write(msg, true);
+		flushQ.clear();
+		flushWriteBuffer();
 	}
 
 	QJsonObject arrayToObj(const QJsonValue &arry) const
@@ -185,17 +493,42 @@ struct TPClientQt::Private
 
 	TPClientQt * const q;
 	QTcpSocket * const socket;
+	QTimer * const sendTimer;
+	QTimer * const writeTimer;
 	QString lastError;
 	QString pluginId;
 	QString tpHost = QStringLiteral("127.0.0.1");
 	uint16_t tpPort = 12136;
 	int connTimeout = 10000;  // ms
 	TPClientQt::TPInfo tpInfo;
-#if TP_CLIENT_ENABLE_SEND_QUEUE
 	std::atomic_bool enableSendQueue = false;
-	std::atomic_bool inQueue = false;
-	QQueue<QByteArray> messageQ;
-#endif
+	int sendInterval = 0;  // ms
+	QVector<QByteArray> messageQ;
+	QVector<QByteArray> flushQ;
+	QHash<QByteArray, int> messageQIndex;  // coalescing key -> index in messageQ
+	std::atomic<quint64> statQueued {0};
+	std::atomic<quint64> statMerged {0};
+	std::atomic<quint64> statWritten {0};
+	std::atomic<quint64> statBytes {0};
+	std::atomic<quint64> statSegments {0};
+	QByteArray writeBuffer;
+	QByteArray encodeBuffer;  // reused by the direct message encoders; never shared, so it keeps its capacity
+
+	// Raw incoming message as split from the read buffer.
+	struct InboundLine {
+		QByteArray data;   // references readBuffer
+		PeekedMessage peek;
+		MessageType type = MessageType::Unknown;
+		bool skip = false;
+	};
+	QByteArray readBuffer;
+	QVector<InboundLine> inboundLines;
+	bool coalesceConnectorChanges = false;
+	std::atomic<quint64> statReceived {0};
+	std::atomic<quint64> statDiscarded {0};
+	std::atomic<quint64> statParseErrors {0};
+	int writeThreshold = 16 * 1024;
+	WriteFlushPolicy flushPolicy = WriteFlushPolicy::LowLatency;
 
 	friend class TPClientQt;
 };
@@ -218,6 +551,8 @@ TPClientQt::TPClientQt(const char *pluginId, QObject *parent) :
 	QObject::connect(d->socket, &QTcpSocket::readyRead, this, &TPClientQt::onReadyRead);
 	QObject::connect(d->socket, &QTcpSocket::disconnected, this, &TPClientQt::disconnected);
 	QObject::connect(d->socket, &QTcpSocket::stateChanged, this, [this](QAbstractSocket::SocketState s) { d->onSockStateChanged(s); });
+	QObject::connect(d->sendTimer, &QTimer::timeout, this, [this]() { d->flushQueue(); });
+	QObject::connect(d->writeTimer, &QTimer::timeout, this, [this]() { d->flushWriteBuffer(); });
 #if (QT_VERSION < QT_VERSION_CHECK(5, 15, 0))
 	QObject::connect(d->socket, qOverload<QAbstractSocket::SocketError>(&QAbstractSocket::error), this, [this](QAbstractSocket::SocketError e) { d->onSocketError(e); });
 #else
@@ -266,10 +601,59 @@ void TPClientQt::setHostProperties(const QString &nameOrAddress, uint16_t port)
 int TPClientQt::connectionTimeout() const { return d_const->connTimeout; }
 void TPClientQt::setConnectionTimeout(int timeoutMs) { d->connTimeout = timeoutMs; }
 
-#if TP_CLIENT_ENABLE_SEND_QUEUE
-void TPClientQt::setSendQueueEnabled(bool enable) { d->enableSendQueue = enable; }
-bool TPClientQt::sendQueueEnabled() const { return d->enableSendQueue; }
-#endif
+bool TPClientQt::sendQueueEnabled() const { return d_const->enableSendQueue; }
+void TPClientQt::setSendQueueEnabled(bool enable)
+{
+	d->enableSendQueue = enable;
+	if (!enable)
+		d->flushQueue();
+}
+
+bool TPClientQt::connectorChangeCoalescing() const { return d_const->coalesceConnectorChanges; }
+void TPClientQt::setConnectorChangeCoalescing(bool enable) { d->coalesceConnectorChanges = enable; }
+
+TPClientQt::ReceiveStatistics TPClientQt::receiveStatistics() const
+{
+	ReceiveStatistics st;
+	st.messagesReceived = d_const->statReceived;
+	st.messagesDiscarded = d_const->statDiscarded;
+	st.parseErrors = d_const->statParseErrors;
+	return st;
+}
+
+int TPClientQt::sendQueueInterval() const { return d_const->sendInterval; }
+void TPClientQt::setSendQueueInterval(int intervalMs) { d->sendInterval = qMax(0, intervalMs); }
+
+TPClientQt::WriteFlushPolicy TPClientQt::writeFlushPolicy() const { return d_const->flushPolicy; }
+void TPClientQt::setWriteFlushPolicy(WriteFlushPolicy policy)
+{
+	d->flushPolicy = policy;
+	if (policy == WriteFlushPolicy::LowLatency)
+		d->flushWriteBuffer();
+}
+
+int TPClientQt::writeBufferThreshold() const { return d_const->writeThreshold; }
+void TPClientQt::setWriteBufferThreshold(int bytes) { d->writeThreshold = qMax(0, bytes); }
+
+TPClientQt::SendStatistics TPClientQt::sendStatistics() const
+{
+	SendStatistics st;
+	st.messagesQueued = d_const->statQueued;
+	st.messagesMerged = d_const->statMerged;
+	st.messagesWritten = d_const->statWritten;
+	st.bytesWritten = d_const->statBytes;
+	st.socketWrites = d_const->statSegments;
+	return st;
+}
+
+void TPClientQt::resetSendStatistics()
+{
+	d->statQueued = 0;
+	d->statMerged = 0;
+	d->statWritten = 0;
+	d->statBytes = 0;
+	d->statSegments = 0;
+}
 
 void TPClientQt::connect()
 {
@@ -291,80 +675,167 @@ void TPClientQt::connect()
 #endif
 
 	d->tpInfo = TPInfo();
+	d->readBuffer.resize(0);
 	d->socket->connectToHost(d->tpHost, d->tpPort);
 }
 
 void TPClientQt::disconnect() const
 {
+	d->flushQueue();
+	d->flushWriteBuffer();
 	d_const->socket->flush();
 	d_const->socket->disconnectFromHost();
 }
 
 void TPClientQt::write(const QByteArray &data) const
 {
-#if TP_CLIENT_ENABLE_SEND_QUEUE
-	if (d_const->enableSendQueue) {
-		static qint64 lastSend = 0;
+	if (d_const->enableSendQueue)
+		d->enqueue(data);
+	else
+		d->write(data);
+}
 
-		d->messageQ.enqueue(data);
-		if (d->inQueue)
-			return;
+void TPClientQt::write(const QByteArray &data, const QByteArray &key) const
+{
+	if (d_const->enableSendQueue)
+		d->enqueue(data, key);
+	else
+		d->write(data);
+}
 
-		d->inQueue = true;
-		QElapsedTimer tim;
-		tim.start();
-		qint64 nextEl = qMax(0LL, lastSend - tim.msecsSinceReference());
-		while (!d->messageQ.isEmpty()) {
-			//qDebug() << "Queue length" << d_const->messageQ.size() << "next:" << nextEl << "now:" << tim.elapsed() << tim.nsecsElapsed();
-			while(tim.elapsed() < nextEl)
-				QCoreApplication::processEvents(QEventLoop::AllEvents);
-			d->write(d->messageQ.dequeue());
-			++nextEl;
-		}
-		lastSend = tim.msecsSinceReference() + 1;
-		d->inQueue = false;
-		//qDebug() << "Queue length" << d_const->messageQ.size() << d_const->sendTimer->interval();
-		return;
-	}
-#endif
-	d_const->write(data);
+void TPClientQt::stateUpdate(const char *id, const char *value) const
+{
+	QByteArray &buff = d->encodeBuffer;
+	buff.resize(0);
+	appendLiteral(buff, "{\"type\":\"stateUpdate\",\"id\":");
+	appendJsonString(buff, id);
+	appendLiteral(buff, ",\"value\":");
+	appendJsonString(buff, value);
+	buff.append('}');
+	d->sendEncoded(id);
+}
+
+void TPClientQt::connectorUpdate(const char *shortId, uint8_t value) const
+{
+	QByteArray &buff = d->encodeBuffer;
+	buff.resize(0);
+	appendLiteral(buff, "{\"type\":\"connectorUpdate\",\"shortId\":");
+	appendJsonString(buff, shortId);
+	appendLiteral(buff, ",\"value\":");
+	appendUInt(buff, value);
+	buff.append('}');
+	d->sendEncoded();
+}
+
+void TPClientQt::settingUpdate(const char *name, const char *value) const
+{
+	QByteArray &buff = d->encodeBuffer;
+	buff.resize(0);
+	appendLiteral(buff, "{\"type\":\"settingUpdate\",\"name\":");
+	appendJsonString(buff, name);
+	appendLiteral(buff, ",\"value\":");
+	appendJsonString(buff, value);
+	buff.append('}');
+	d->sendEncoded();
 }
 
 // private
 
 void TPClientQt::onReadyRead()
 {
+	QByteArray &rb = d->readBuffer;
+	rb.append(d->socket->readAll());
+
+	// Split complete lines and peek at their type w/out copying or parsing the whole message.
+	QVector<Private::InboundLine> &lines = d->inboundLines;
+	lines.resize(0);
+	const char * const data = rb.constData();
+	const char * const end = data + rb.size();
+	const char *pos = data;
+	while (pos < end) {
+		const char *eol = static_cast<const char *>(memchr(pos, '\n', end - pos));
+		if (!eol)
+			break;
+		const char *lineEnd = eol;
+		if (lineEnd > pos && lineEnd[-1] == '\r')
+			--lineEnd;
+		if (lineEnd > pos) {
+			Private::InboundLine line;
+			line.data = QByteArray::fromRawData(pos, int(lineEnd - pos));
+			if (peekMessage(pos, lineEnd, line.peek) && !line.peek.type.isEmpty())
+				line.type = decodeMessageType(line.peek.type.constData(), line.peek.type.length());
+			lines.append(line);
+		}
+		pos = eol + 1;
+	}
+	if (pos == data)
+		return;
+	d->statReceived += lines.size();
+
+	// Only the latest value of a slider matters, so skip any earlier changes from the same slider in this batch. The connectorId only identifies
+	// the type of connector, the actual slider is identified by its data members (instance name, expression, etc.), so both have to match.
+	if (d_const->coalesceConnectorChanges && lines.size() > 1) {
+		QSet<QByteArray> seen;
+		for (int i = lines.size() - 1; i > -1; --i) {
+			Private::InboundLine &line = lines[i];
+			if (line.type != MessageType::connectorChange || line.peek.connectorId.isEmpty() || line.peek.data.isEmpty())
+				continue;
+			const QByteArray key = line.peek.connectorId + '\0' + line.peek.data;
+			if (seen.contains(key)) {
+				line.skip = true;
+				++d->statDiscarded;
+			}
+			else {
+				seen.insert(key);
+			}
+		}
+	}
+
 	QJsonParseError jpe;
-	while (d->socket->canReadLine()) {
-		const QByteArray &bytes = d->socket->readLine();
-		if (bytes.isEmpty())
-			continue;;
-		const QJsonDocument &js = QJsonDocument::fromJson(bytes, &jpe);
+	for (const Private::InboundLine &line : qAsConst(lines)) {
+		if (line.skip)
+			continue;
+		if (line.type == MessageType::connectorChange) {
+			QJsonObject msg;
+			if (buildConnectorChange(line.peek, msg)) {
+				d->onTpMessage(line.type, msg);
+				continue;
+			}
+		}
+		const QJsonDocument &js = QJsonDocument::fromJson(line.data, &jpe);
 		if (!js.isObject()) {
+			++d->statParseErrors;
 			if (jpe.error == QJsonParseError::NoError)
 				qCWarning(lcTPC) << "Got empty or invalid JSON data, with no parsing error.";
 			else
 				qCWarning(lcTPC) << "Got invalid JSON data:" << jpe.errorString() << "; @" << jpe.offset;
-			qCDebug(lcTPC) << bytes;
+			qCDebug(lcTPC) << line.data;
 			continue;
 		}
 		const QJsonObject &msg = js.object();
 		//	qCDebug(lcTPC) << msg;
-		const QJsonValue &jMsgType = msg.value(QLatin1String("type"));
-		if (!jMsgType.isString()) {
-			qCWarning(lcTPC) << "TP message data missing the 'type' property.";
-			qCDebug(lcTPC) << msg;
-			continue;
-		}
-
-		bool ok;
-		MessageType iMsgType = (MessageType)QMetaEnum::fromType<TPClientQt::MessageType>().keyToValue(qPrintable(jMsgType.toString()), &ok);
-		if (!ok) {
-			iMsgType = MessageType::Unknown;
-			qCWarning(lcTPC) << "Unknown TP message 'type' property:" << jMsgType.toString();
+		MessageType iMsgType = line.type;
+		if (iMsgType == MessageType::Unknown) {
+			// The quick scan failed or found an unknown type; check the parsed message.
+			const QJsonValue &jMsgType = msg.value(QLatin1String("type"));
+			if (!jMsgType.isString()) {
+				qCWarning(lcTPC) << "TP message data missing the 'type' property.";
+				qCDebug(lcTPC) << msg;
+				continue;
+			}
+			const QByteArray type = jMsgType.toString().toUtf8();
+			iMsgType = decodeMessageType(type.constData(), type.length());
+			if (iMsgType == MessageType::Unknown)
+				qCWarning(lcTPC) << "Unknown TP message 'type' property:" << jMsgType.toString();
 		}
 		d->onTpMessage(iMsgType, msg);
 	}
+
+	// Drop the processed data; any partial line stays at the start of the buffer.
+	if (pos == end)
+		rb.resize(0);
+	else
+		rb.remove(0, int(pos - data));
 }
 
 #include "moc_TPClientQt.cpp"
@@ -45,10 +45,6 @@ to any 3rd-party components used within.
 	#endif
 #endif
 
-#ifndef TP_CLIENT_ENABLE_SEND_QUEUE
-	#define TP_CLIENT_ENABLE_SEND_QUEUE 0
-#endif
-
 Q_DECLARE_LOGGING_CATEGORY(lcTPC);
 
 /**
@@ -62,9 +58,15 @@ passes the message data on as a `QJsonObject`. Beyond determining the message ty
 
 Sending messages to TP can be done at 3 different levels:
 - The (very overloaded) methods provided by this class which have names eponymous with the corresponding TP API message types. Eg: `stateUpdate()`, `showNotification()`, etc.
+  The highest volume message types (`stateUpdate()`, `connectorUpdate()` by short ID, and `settingUpdate()`) are serialized directly into a reusable buffer
+  instead of going through `QJsonObject`.
 - Arbitrary JSON object via the `send()` method or from a serialized `QVariantMap` via `sendMap()`;
 - Raw bytes with the `write()` method.
 
+Outgoing messages can optionally be routed through a coalescing send queue (see `setSendQueueEnabled()`). When enabled, messages are collected and written
+to the network in one pass per event loop iteration (or per `sendQueueInterval()` period). A state update for a state ID which is still waiting in the queue
+replaces the older value instead of being sent separately ("latest value wins"), so rapidly changing states do not flood Touch Portal with stale values.
+
 The client emits `connected()`, `disconnected()`, and `error()` signals to notify the plugin of connection status and network state changes.
 Disconnections may happen spontaneously for a number of reasons (socket error, TP quitting, etc). Notably, `error()` is emitted if the initial connection to Touch Portal fails.
 
@@ -107,6 +109,13 @@ class TPCLIENT_LIB_EXPORT TPClientQt : public QObject
 		};
 		Q_ENUM(MessageType)
 
+		//! Policy for combining outgoing messages into socket writes. \sa setWriteFlushPolicy()
+		enum class WriteFlushPolicy : short {
+			LowLatency,  //!< Each message (and its newline terminator) is written to the socket as soon as it is sent. This is the default.
+			Throughput,  //!< Messages are collected in a buffer which is written to the socket once the event loop is idle, or when `writeBufferThreshold()` is reached.
+		};
+		Q_ENUM(WriteFlushPolicy)
+
 		//! Structure to hold information about current Touch Portal session. Populated from the initial 'info' message properties upon connection.
 		//! Member names are eponymous with the properties of the 'info' message (except `paired`, see note on that).
 		//! This struct is registered with Qt meta system and is suitable for queued signals/slots.  \sa tpInfo()
@@ -119,6 +128,15 @@ class TPCLIENT_LIB_EXPORT TPClientQt : public QObject
 			QString status;               //!< The 'status' property from initial 'info' message (typically "paired"); This does _not_ get changed after disconnection (see `paired`).
 		};
 
+		//! Structure holding statistics about outgoing messages. \sa sendStatistics(), resetSendStatistics()
+		struct SendStatistics {
+			quint64 messagesQueued = 0;   //!< Number of messages added to the send queue (only counted when the queue is enabled).
+			quint64 messagesMerged = 0;   //!< Number of queued messages which were replaced by a newer message with the same key (eg. state ID) before being sent.
+			quint64 messagesWritten = 0;  //!< Number of messages actually written to the network socket.
+			quint64 bytesWritten = 0;     //!< Total number of bytes written to the network socket, including message terminators.
+			quint64 socketWrites = 0;     //!< Number of write operations on the network socket; each one may contain any number of messages.
+		};
+
 		//! Structure for action/connector data id = value pairs sent from TP. Each action/connector sends an array of these.
 		//! Used with some convenience functions in this class.  \sa actionDataItem(), actionDataToItemArray()
 		struct ActionDataItem {
@@ -126,6 +144,13 @@ class TPCLIENT_LIB_EXPORT TPClientQt : public QObject
 			QString value;   //!< Current value of the data member.
 		};
 
+		//! Structure holding statistics about incoming messages. \sa receiveStatistics()
+		struct ReceiveStatistics {
+			quint64 messagesReceived = 0;   //!< Number of message lines read from the network socket.
+			quint64 messagesDiscarded = 0;  //!< Number of `connectorChange` messages skipped because a newer value from the same slider was already received. \sa setConnectorChangeCoalescing()
+			quint64 parseErrors = 0;        //!< Number of messages which could not be parsed as a JSON object.
+		};
+
 		//! The constructor creates the instance but does not attempt any connections.
 		//! The `pluginId` will be used in the initial pairing message sent to Touch Portal, and must match ID in the plugin's entry.tp config file.
 		//! You could pass a null ID here and set it later with `setPluginId()`, but an ID _is_ required before trying to connect to TP.
@@ -169,10 +194,41 @@ class TPCLIENT_LIB_EXPORT TPClientQt : public QObject
 		//! The default value is 10000 (10s). Call this method with no argument to reset the timeout value to default.  \sa connectionTimeout()
 		void setConnectionTimeout(int timeoutMs = 10000);
 
-#if TP_CLIENT_ENABLE_SEND_QUEUE
-		Q_INVOKABLE void setSendQueueEnabled(bool enable = true);
+		//! Returns `true` if the coalescing send queue is enabled. The queue is disabled by default. \sa setSendQueueEnabled()
 		bool sendQueueEnabled() const;
-#endif
+		//! Enables or disables the coalescing send queue. When enabled, all outgoing messages are queued and written in order once per event loop pass
+		//! (or after the `sendQueueInterval()` period), and a queued state update is replaced by any newer update to the same state ID which arrives
+		//! before the queue is flushed. Any other message type acts as an ordering barrier, so state updates are never merged across, eg., a `removeState()` message.
+		//! Disabling the queue immediately writes any pending messages. This should be called from the thread the client lives in.  \sa sendQueueInterval(), sendStatistics()
+		Q_INVOKABLE void setSendQueueEnabled(bool enable = true);
+		//! Returns the send queue flush interval, in milliseconds. \sa setSendQueueInterval()
+		int sendQueueInterval() const;
+		//! Sets the send queue flush interval, in milliseconds. With the default of `0` the queue is flushed once per event loop pass, as soon as all pending events
+		//! have been processed. A longer interval lets more updates be merged, at the cost of added latency. Only relevant when `sendQueueEnabled()` is `true`.
+		void setSendQueueInterval(int intervalMs = 0);
+		//! Returns `true` if superseded `connectorChange` messages are discarded. \sa setConnectorChangeCoalescing()
+		bool connectorChangeCoalescing() const;
+		//! When enabled, if several `connectorChange` messages from the same slider (same `connectorId` and identical `data` members) arrive in one network read,
+		//! only the last one is parsed and delivered via the `message()` signal; the earlier values are counted in `ReceiveStatistics::messagesDiscarded`.
+		//! Disabled by default.
+		void setConnectorChangeCoalescing(bool enable = true);
+		//! Returns statistics about received messages. This method is thread-safe. \sa ReceiveStatistics
+		ReceiveStatistics receiveStatistics() const;
+
+		//! Returns the current write combining policy. \sa setWriteFlushPolicy()
+		WriteFlushPolicy writeFlushPolicy() const;
+		//! Sets the policy for combining outgoing messages into socket writes. In all cases each message and its newline terminator are written in one operation.
+		//! With `WriteFlushPolicy::Throughput` messages are appended to a single buffer which is flushed when control returns to an idle event loop, or as soon as
+		//! `writeBufferThreshold()` bytes are pending. Messages flushed from the send queue are always combined into one write. \sa WriteFlushPolicy, sendStatistics()
+		void setWriteFlushPolicy(WriteFlushPolicy policy);
+		//! Returns the size, in bytes, of pending buffered data which triggers an immediate write with the `WriteFlushPolicy::Throughput` policy. \sa setWriteBufferThreshold()
+		int writeBufferThreshold() const;
+		//! Sets the size, in bytes, of pending buffered data which triggers an immediate write with the `WriteFlushPolicy::Throughput` policy. Default is 16KiB.
+		void setWriteBufferThreshold(int bytes = 16 * 1024);
+		//! Returns statistics about the number of queued, merged, and written messages, and the number of bytes and write operations on the socket. This method is thread-safe.  \sa SendStatistics
+		SendStatistics sendStatistics() const;
+		//! Resets all the `sendStatistics()` counters to zero. This method is thread-safe.
+		void resetSendStatistics();
 
 		//! \}
 
@@ -201,7 +257,8 @@ class TPCLIENT_LIB_EXPORT TPClientQt : public QObject
 		//! \{
 
 		//! Send a state update with given `id` and `value` strings.
-		inline void stateUpdate(const char *id, const char *value) const;
+		//! This message is encoded directly to JSON bytes, bypassing `QJsonObject` and `encode()`. With the send queue enabled, a pending update of the same state is replaced.
+		void stateUpdate(const char *id, const char *value) const;
 		//! Create a new dynamic state with given `id`, `parentGroup`, `description` and default value strings. Passing `nullptr` to `defaultValue` is same as using an empty string.
 		inline void createState(const char *id, const char *parentGroup, const char *desc, const char *defaultValue) const;
 		//! Create a new dynamic state with given `id`, `parentGroup`, `description` and default value strings.
@@ -233,7 +290,8 @@ class TPCLIENT_LIB_EXPORT TPClientQt : public QObject
 		inline void choiceUpdate(const std::string &id, const std::string &instanceId, const std::vector<std::string> &values) const { choiceUpdate(id.c_str(), instanceId.c_str(), stringContainerToJsonArray(values)); }
 
 		//! Update a Connector value with given `shortId` as reported by TP. Valid value range is 0-100.
-		inline void connectorUpdate(const char *shortId, uint8_t value) const;
+		//! This message is encoded directly to JSON bytes, bypassing `QJsonObject` and `encode()`.
+		void connectorUpdate(const char *shortId, uint8_t value) const;
 		//! Update a Connector value with given `shortId` as reported by TP. Valid value range is 0-100.
 		inline void connectorUpdate(const std::string &shortId, uint8_t value) const { connectorUpdate(shortId.c_str(), value); }
 
@@ -249,7 +307,8 @@ class TPCLIENT_LIB_EXPORT TPClientQt : public QObject
 		inline void connectorUpdate(const char *connectortId, const QMap<const char*, const char*> &nvPairs, uint8_t value, bool addPrefix = true) const;
 
 		//! Update a plugin setting value with given `name` to `value`.
-		inline void settingUpdate(const char *name, const char *value) const;
+		//! This message is encoded directly to JSON bytes, bypassing `QJsonObject` and `encode()`.
+		void settingUpdate(const char *name, const char *value) const;
 		//! Update a plugin setting value with given `name` to `value`.
 		inline void settingUpdate(const std::string &name, const std::string &value) const { settingUpdate(name.c_str(), value.c_str()); }
 
@@ -309,8 +368,12 @@ class TPCLIENT_LIB_EXPORT TPClientQt : public QObject
 		//! Low-level API: Send a JSON representation of a variant map to Touch Portal. `map` should contain one TP message. The map is serialized as QJsonObject type.
 		inline void sendMap(const QVariantMap &map) const { write(encode(QJsonObject::fromVariantMap(map))); }
 		//! Low-level API: Write UTF-8 bytes directly to Touch Portal. `data` should contain one TP message in the form of a serialized (UTF8 text) JSON object.
-		//! A newline is automatically added after `data` is sent (as per TP API specs). All messages are ultimately sent via this method.
+		//! A newline is automatically added after `data` is sent (as per TP API specs). All messages are ultimately sent via this method (or the keyed overload).
 		void write(const QByteArray &data) const;
+		//! Low-level API: Same as `write(data)` but if the send queue is enabled and a message with the same `key` is still waiting to be sent, then that message is replaced
+		//! with `data` (keeping its place in the queue) instead of queuing a new one. `stateUpdate()` uses this with the state ID as the key.
+		//! An empty `key` is equivalent to calling `write(data)`.  \sa setSendQueueEnabled()
+		void write(const QByteArray &data, const QByteArray &key) const;
 
 		//! \}
 
@@ -512,16 +575,6 @@ void TPClientQt::connect(int timeout, const QString &host, uint16_t port)
 	connect();
 }
 
-inline
-void TPClientQt::stateUpdate(const char *id, const char *value) const
-{
-	send({
-		{"type", "stateUpdate"},
-		{"id", id},
-		{"value", value}
-	});
-}
-
 inline
 void TPClientQt::createState(const char *id, const char *parentGroup, const char *desc, const char *defaultValue) const
 {
@@ -564,16 +617,6 @@ void TPClientQt::choiceUpdate(const char *id, const char *instanceId, const QJso
 	});
 }
 
-inline
-void TPClientQt::connectorUpdate(const char *shortId, uint8_t value) const
-{
-	send({
-		{"type", "connectorUpdate"},
-		{"shortId", shortId},
-		{"value", value}
-	});
-}
-
 inline
 void TPClientQt::connectorUpdate(const char *connectortId, uint8_t value, bool addPrefix) const
 {
@@ -611,16 +654,6 @@ void TPClientQt::connectorUpdate(QStringView connectortId, const QMap<QStringVie
 	connectorUpdate(fullId.toUtf8(), value, addPrefix);
 }
 
-inline
-void TPClientQt::settingUpdate(const char *name, const char *value) const
-{
-	send({
-		{"type", "settingUpdate"},
-		{"name", name},
-		{"value", value}
-	});
-}
-
 inline
 void TPClientQt::showNotification(const char *notificationId, const char *title, const char *msg, const QJsonArray &options) const
 {
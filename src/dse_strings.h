@@ -35,6 +35,10 @@ enum StateIdToken
 	SID_TpDataPath,
 	SID_TpCurrentPage,
 	SID_PluginState,
+	SID_EvalTimeoutCount,
+	SID_EvalMaxDuration,
+	SID_EnginesHeapSize,
+	SID_GcCount,
 
 	SID_ENUM_MAX
 };
@@ -89,6 +93,10 @@ static constexpr const char * g_tokenStrings[STRING_TOKENS_COUNT]
 	"tpDataPath",
 	"currentPage",
 	"pluginState",
+	"evalTimeoutCount",
+	"evalMaxDuration",
+	"enginesHeapSize",
+	"gcCount",
 
 	"script",
 	"plugin",
@@ -151,6 +159,10 @@ enum ActionTokens {
 	ST_ScriptsBaseDir,
 	ST_SettingsVersion,
 	ST_LoadScriptAtStart,
+	ST_EnginePoolSize,
+	ST_EngineThreads,
+	ST_SharedEngines,
+	ST_EvalTimeLimit,
 
 	AT_Script,
 	AT_Engine,
@@ -197,6 +209,10 @@ static QByteArray tokenToName(int token, const QByteArray &deflt = QByteArray())
 	  { ST_ScriptsBaseDir, "Script Files Base Directory" },
 	  { ST_SettingsVersion,   "Settings Version" },
 	  { ST_LoadScriptAtStart, "Load Script At Startup" },
+	  { ST_EnginePoolSize,    "Private Engine Pool Size" },
+	  { ST_EngineThreads,     "Private Engine Threads" },
+	  { ST_SharedEngines,     "Shared Engine Count" },
+	  { ST_EvalTimeLimit,     "Script Evaluation Time Limit (ms)" },
 
 	  // Plugin running state State values, used in Event evaluation.
 	  { AT_Starting,  "Starting" },
@@ -277,6 +293,10 @@ static int tokenFromName(const QByteArray &name, int deflt = AT_Unknown)
 	  { tokenToName(ST_ScriptsBaseDir),    ST_ScriptsBaseDir },
 	  { tokenToName(ST_SettingsVersion),   ST_SettingsVersion },
 	  { tokenToName(ST_LoadScriptAtStart), ST_LoadScriptAtStart },
+	  { tokenToName(ST_EnginePoolSize),    ST_EnginePoolSize },
+	  { tokenToName(ST_EngineThreads),     ST_EngineThreads },
+	  { tokenToName(ST_SharedEngines),     ST_SharedEngines },
+	  { tokenToName(ST_EvalTimeLimit),     ST_EvalTimeLimit },
 
 	  { tokenToName(AT_Script),    AT_Script },
 	  { tokenToName(AT_Engine),    AT_Engine },
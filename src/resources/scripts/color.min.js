@@ -0,0 +1 @@
+(function(a){"use strict";function b(b){var d={r:0,g:0,b:0},f=1,h=null,i=null,j=null,k=!1,m=!1;return"string"==typeof b&&(b=K(b)),"object"==typeof b&&(J(b.r)&&J(b.g)&&J(b.b)?(d=c(b.r,b.g,b.b),k=!0,m="%"===(b.r+"").substr(-1)?"prgb":"rgb"):J(b.h)&&J(b.s)&&(h=G(b.s),J(b.v)?(i=G(b.v),d=g(b.h,h,i),k=!0,m="hsv"):J(b.l)&&(j=G(b.l),d=e(b.h,h,j),k=!0,m="hsl")),b.hasOwnProperty("a")&&(f=b.a)),f=z(f),{ok:k,format:b.format||m,r:P(255,Q(d.r,0)),g:P(255,Q(d.g,0)),b:P(255,Q(d.b,0)),a:f}}function c(a,c,d){return{r:255*A(a,255),g:255*A(c,255),b:255*A(d,255)}}function d(a,c,e){a=A(a,255),c=A(c,255),e=A(e,255);var f,i,j=Q(a,c,e),k=P(a,c,e),m=(j+k)/2;if(j==k)f=i=0;else{var l=j-k;i=.5<m?l/(2-j-k):l/(j+k);j===a?f=(c-e)/l+(c<e?6:0):j===c?f=(e-a)/l+2:j===e?f=(a-c)/l+4:void 0;f/=6}return{h:f,s:i,l:m}}function e(a,c,d){function e(a,b,c){return 0>c&&(c+=1),1<c&&(c-=1),c<1/6?a+6*(b-a)*c:c<1/2?b:c<2/3?a+6*((b-a)*(2/3-c)):a}var f,i,j;if(a=A(a,360),c=A(c,100),d=A(d,100),0===c)f=i=j=d;else{var k=.5>d?d*(1+c):d+c-d*c,m=2*d-k;f=e(m,k,a+1/3),i=e(m,k,a),j=e(m,k,a-1/3)}return{r:255*f,g:255*i,b:255*j}}function f(a,c,e){a=A(a,255),c=A(c,255),e=A(e,255);var f,i,j=Q(a,c,e),k=P(a,c,e),l=j,m=j-k;return i=0===j?0:m/j,j==k?f=0:(j===a?f=(c-e)/m+(c<e?6:0):j===c?f=(e-a)/m+2:j===e?f=(a-c)/m+4:void 0,f/=6),{h:f,s:i,v:l}}function g(c,d,e){c=6*A(c,360),d=A(d,100),e=A(e,100);var j=a.floor(c),i=c-j,f=e*(1-d),k=e*(1-i*d),l=e*(1-(1-i)*d),m=j%6,n=[e,k,f,f,l,e][m],o=[l,e,e,k,f,f][m],g=[f,f,l,e,e,k][m];return{r:255*n,g:255*o,b:255*g}}function h(a,c,d,b){var e=[F(O(a).toString(16)),F(O(c).toString(16)),F(O(d).toString(16))];return b&&e[0].charAt(0)==e[0].charAt(1)&&e[1].charAt(0)==e[1].charAt(1)&&e[2].charAt(0)==e[2].charAt(1)?e[0].charAt(0)+e[1].charAt(0)+e[2].charAt(0):e.join("")}function i(c,d,e,b,a){var f=[F(O(c).toString(16)),F(O(d).toString(16)),F(O(e).toString(16)),F(H(b))];return a&&f[0].charAt(0)==f[0].charAt(1)&&f[1].charAt(0)==f[1].charAt(1)&&f[2].charAt(0)==f[2].charAt(1)&&f[3].charAt(0)==f[3].charAt(1)?f[0].charAt(0)+f[1].charAt(0)+f[2].charAt(0)+f[3].charAt(0):f.join("")}function j(c,d,e,b){var a=[F(H(b)),F(O(c).toString(16)),F(O(d).toString(16)),F(O(e).toString(16))];return a.join("")}function k(a,b){b=0===b?0:b||10;var c=tinycolor(a).toHsl();return c.s-=b/100,c.s=B(c.s),tinycolor(c)}function l(a,b){b=0===b?0:b||10;var c=tinycolor(a).toHsl();return c.s+=b/100,c.s=B(c.s),tinycolor(c)}function m(a){return tinycolor(a).desaturate(100)}function n(a,b){b=0===b?0:b||10;var c=tinycolor(a).toHsl();return c.l+=b/100,c.l=B(c.l),tinycolor(c)}function o(a,b){b=0===b?0:b||10;var c=tinycolor(a).toRgb();return c.r=Q(0,P(255,c.r-O(255*-(b/100)))),c.g=Q(0,P(255,c.g-O(255*-(b/100)))),c.b=Q(0,P(255,c.b-O(255*-(b/100)))),tinycolor(c)}function p(a,b){b=0===b?0:b||10;var c=tinycolor(a).toHsl();return c.l-=b/100,c.l=B(c.l),tinycolor(c)}function q(a,b){var c=tinycolor(a).toHsl(),d=(c.h+b)%360;return c.h=0>d?360+d:d,tinycolor(c)}function r(a,b,c){c=0===c?0:c||50;var d=tinycolor(a).toRgb(),e=tinycolor(b).toRgb(),f=c/100,g={r:(e.r-d.r)*f+d.r,g:(e.g-d.g)*f+d.g,b:(e.b-d.b)*f+d.b,a:(e.a-d.a)*f+d.a};return tinycolor(g)}function s(a,b){return b=0===b?0:b||10,r(a,"white",b)}function t(a,b){return b=0===b?0:b||10,r(a,"black",b)}function u(a){var b=tinycolor(a).toHsl();return b.h=(b.h+180)%360,tinycolor(b)}function v(a,b){var c=tinycolor(a).toHsl(),d=c.h;b=b&&0<b?b:5;for(var e=[tinycolor(a)],f=360/b,g=1;g<b;g++)e.push(tinycolor({h:(d+g*f)%360,s:c.s,l:c.l,a:a._a}));return e}function w(a){var b=tinycolor(a).toHsl(),c=b.h;return[tinycolor(a),tinycolor({h:(c+72)%360,s:b.s,l:b.l,a:a._a}),tinycolor({h:(c+216)%360,s:b.s,l:b.l,a:a._a})]}function x(a,b,c){b=b&&0<b?b:6,c=c&&0<c?c:30;var d=tinycolor(a).toHsl(),e=360/c,f=[tinycolor(a)];for(d.h=(d.h-(e*b>>1)+720)%360;--b;)d.h=(d.h+e)%360,f.push(tinycolor(d));return f}function y(b,c){c=c&&0<c?c:6;for(var d=tinycolor(b).toHsv(),e=d.h,f=d.s,g=d.v,h=b._a,a=[],i=1/c;c--;)a.push(tinycolor({h:e,s:f,v:g,a:h})),g=(g+i)%1;return a}function z(b){return b=parseFloat(b),(isNaN(b)||0>b||1<b)&&(b=1),b}function A(b,c){D(b)&&(b="100%");var d=E(b);return b=360===c?b:P(c,Q(0,parseFloat(b))),d&&(b=parseInt(b*c,10)/100),1e-6>a.abs(b-c)?1:360===c?(0>b?b%c+c:b%c)/360:b%c/parseFloat(c)}function B(a){return P(1,Q(0,a))}function C(a){return parseInt(a,16)}function D(a){return"string"==typeof a&&-1!=a.indexOf(".")&&1===parseFloat(a)}function E(a){return"string"==typeof a&&-1!=a.indexOf("%")}function F(a){return 1==a.length?"0"+a:""+a}function G(a){return 1>=a&&(a=100*a+"%"),a}function H(b){return a.round(255*parseFloat(b)).toString(16)}function I(a){return C(a)/255}function J(a){return!!V.CSS_UNIT.exec(a)}function K(a){a=a.replace(M,"").replace(N,"").toLowerCase();var b=!1;T[a]&&(a=T[a],b=!0);var c;return(c=V.rgb.exec(a))?{r:c[1],g:c[2],b:c[3]}:(c=V.rgba.exec(a))?{r:c[1],g:c[2],b:c[3],a:c[4]}:(c=V.hsl.exec(a))?{h:c[1],s:c[2],l:c[3]}:(c=V.hsla.exec(a))?{h:c[1],s:c[2],l:c[3],a:c[4]}:(c=V.hsv.exec(a))?{h:c[1],s:c[2],v:c[3]}:(c=V.hsva.exec(a))?{h:c[1],s:c[2],v:c[3],a:c[4]}:(c=V.hex8.exec(a))?{r:C(c[1]),g:C(c[2]),b:C(c[3]),a:I(c[4]),format:b?"name":"hex8"}:(c=V.hex6.exec(a))?{r:C(c[1]),g:C(c[2]),b:C(c[3]),format:b?"name":"hex"}:(c=V.hex4.exec(a))?{r:C(c[1]+""+c[1]),g:C(c[2]+""+c[2]),b:C(c[3]+""+c[3]),a:I(c[4]+""+c[4]),format:b?"name":"hex8"}:!!(c=V.hex3.exec(a))&&{r:C(c[1]+""+c[1]),g:C(c[2]+""+c[2]),b:C(c[3]+""+c[3]),format:b?"name":"hex"}}function L(a){var b,c;return a=a||{level:"AA",size:"small"},b=(a.level||"AA").toUpperCase(),c=(a.size||"small").toLowerCase(),"AA"!==b&&"AAA"!==b&&(b="AA"),"small"!==c&&"large"!==c&&(c="small"),{level:b,size:c}}var M=/^\s+/,N=/\s+$/,O=a.round,P=a.min,Q=a.max,R=a.random,S=a.abs;tinycolor=function(a,c){if(a=a?a:"",c=c||{},a instanceof tinycolor)return a;if(!(this instanceof tinycolor))return new tinycolor(a,c);var d=b(a);this._originalInput=a,this._r=d.r,this._g=d.g,this._b=d.b,this._a=d.a,this._roundA=O(100*this._a)/100,this._format=c.format||d.format,this._gradientType=c.gradientType,1>this._r&&(this._r=O(this._r)),1>this._g&&(this._g=O(this._g)),1>this._b&&(this._b=O(this._b)),this._ok=d.ok},tinycolor.prototype={isValid:function(){return this._ok},isDark:function(){return 128>this.getBrightness()},isLight:function(){return!this.isDark()},isWarm:function(){return this._r>this._b},isCool:function(){return!this.isWarm()},getOriginalInput:function(){return this._originalInput},getFormat:function(){return this._format},getAlpha:function(){return this._a},getBrightness:function(){var a=this.toRgb();return(299*a.r+587*a.g+114*a.b)/1e3},getLuminance:function(){var b,c,d,e,f,g,h=this.toRgb();return b=h.r/255,c=h.g/255,d=h.b/255,e=.03928>=b?b/12.92:a.pow((b+.055)/1.055,2.4),f=.03928>=c?c/12.92:a.pow((c+.055)/1.055,2.4),g=.03928>=d?d/12.92:a.pow((d+.055)/1.055,2.4),.2126*e+.7152*f+.0722*g},getSaturation:function(){var a=this.toRgb(),b=Q(a.r,a.g,a.b)/255,c=P(a.r,a.g,a.b)/255,d=this.getLuminance();return 1===d?0:(b-c)/(1-S(2*d-1))},setAlpha:function(a){return this._a=z(a),this._roundA=O(100*this._a)/100,this},toHsv:function(){var a=f(this._r,this._g,this._b);return{h:360*a.h,s:a.s,v:a.v,a:this._a}},toHsvString:function(){var a=f(this._r,this._g,this._b),b=O(360*a.h),c=O(100*a.s),d=O(100*a.v);return 1==this._a?"hsv("+b+", "+c+"%, "+d+"%)":"hsva("+b+", "+c+"%, "+d+"%, "+this._roundA+")"},toHsl:function(){var a=d(this._r,this._g,this._b);return{h:360*a.h,s:a.s,l:a.l,a:this._a}},toHslString:function(){var a=d(this._r,this._g,this._b),b=O(360*a.h),c=O(100*a.s),e=O(100*a.l);return 1==this._a?"hsl("+b+", "+c+"%, "+e+"%)":"hsla("+b+", "+c+"%, "+e+"%, "+this._roundA+")"},toHex:function(a){return h(this._r,this._g,this._b,a)},toHexString:function(a){return"#"+this.toHex(a)},toHex8:function(a){return i(this._r,this._g,this._b,this._a,a)},toHex8String:function(a){return"#"+this.toHex8(a)},toArgbHex:function(){return j(this._r,this._g,this._b,this._a)},toArgbHexString:function(){return"#"+this.toArgbHex()},toRgb:function(){return{r:O(this._r),g:O(this._g),b:O(this._b),a:this._a}},toRgbString:function(){return 1==this._a?"rgb("+O(this._r)+", "+O(this._g)+", "+O(this._b)+")":"rgba("+O(this._r)+", "+O(this._g)+", "+O(this._b)+", "+this._roundA+")"},toPercentageRgb:function(){return{r:O(100*A(this._r,255))+"%",g:O(100*A(this._g,255))+"%",b:O(100*A(this._b,255))+"%",a:this._a}},toPercentageRgbString:function(){return 1==this._a?"rgb("+O(100*A(this._r,255))+"%, "+O(100*A(this._g,255))+"%, "+O(100*A(this._b,255))+"%)":"rgba("+O(100*A(this._r,255))+"%, "+O(100*A(this._g,255))+"%, "+O(100*A(this._b,255))+"%, "+this._roundA+")"},toName:function(){return 0===this._a&&255===this._r&&255===this._g&&255===this._b?"transparent":!(1>this._a)&&(U[h(this._r,this._g,this._b,!0)]||!1)},toFilter:function(a){var b="#"+j(this._r,this._g,this._b,this._a),c=b,d=this._gradientType?"GradientType = 1, ":"";if(a){var e=tinycolor(a);c="#"+j(e._r,e._g,e._b,e._a)}return"progid:DXImageTransform.Microsoft.gradient("+d+"startColorstr="+b+",endColorstr="+c+")"},toString:function(a){var b=!!a;a=a||this._format;var c=1>this._a&&0<=this._a,d=!b&&c&&("hex"===a||"hex6"===a||"hex3"===a||"hex4"===a||"hex8"===a||"name"===a);if(d)return"name"===a&&0===this._a?this.toName():this.toRgbString();return"rgb"===a?this.toRgbString():"prgb"===a?this.toPercentageRgbString():"hex3"===a?this.toHexString(!0):"hex4"===a?this.toHex8String(!0):"hex8"===a||"rgba"===a?this.toHex8String():"hex8a"===a||"argb"===a?this.toArgbHexString():"name"===a?this.toName()||this.toHexString():"hsl"===a?this.toHslString():"hsv"===a?this.toHsvString():this.toHexString()},clone:function(){return tinycolor(this.toString())},_applyModification:function(a,b){var c=a.apply(null,[this].concat([].slice.call(b)));return this._r=c._r,this._g=c._g,this._b=c._b,this.setAlpha(c._a),this},lighten:function(){return this._applyModification(n,arguments)},brighten:function(){return this._applyModification(o,arguments)},darken:function(){return this._applyModification(p,arguments)},desaturate:function(){return this._applyModification(k,arguments)},saturate:function(){return this._applyModification(l,arguments)},greyscale:function(){return this._applyModification(m,arguments)},spin:function(){return this._applyModification(q,arguments)},mixWith:function(){return this._applyModification(r,arguments)},tint:function(){return this._applyModification(s,arguments)},shade:function(){return this._applyModification(t,arguments)},_applyCombination:function(a,b){return a.apply(null,[this].concat([].slice.call(b)))},analogous:function(){return this._applyCombination(x,arguments)},complement:function(){return this._applyCombination(u,arguments)},monochromatic:function(){return this._applyCombination(y,arguments)},splitcomplement:function(){return this._applyCombination(w,arguments)},triad:function(){return this._applyCombination(v,[3])},tetrad:function(){return this._applyCombination(v,[4])},polyad:function(a){return this._applyCombination(v,[a])},isDarkerThan:function(a){return this.getBrightness()<a.getBrightness()},isLighterThan:function(a){return!this.isDarker(a)},isWarmerThan:function(a){return!!(this._r>a._r)||!(this._r!=a._r)&&this._b+this._g<a._b+a._g},isCoolerThan:function(a){return!this.isWarmer(a)}},tinycolor.prototype.originalInput=tinycolor.prototype.getOriginalInput,tinycolor.prototype.format=tinycolor.prototype.getFormat,tinycolor.prototype.alpha=tinycolor.prototype.getAlpha,tinycolor.prototype.brightness=tinycolor.prototype.getBrightness,tinycolor.prototype.luminance=tinycolor.prototype.getLuminance,tinycolor.prototype.saturation=tinycolor.prototype.getSaturation,tinycolor.prototype.hsv=tinycolor.prototype.toHsvString,tinycolor.prototype.hsl=tinycolor.prototype.toHslString,tinycolor.prototype.hex=tinycolor.prototype.toHexString,tinycolor.prototype.rgba=tinycolor.prototype.toHex8String,tinycolor.prototype.argb=tinycolor.prototype.toArgbHexString,tinycolor.prototype.tpcolor=tinycolor.prototype.toArgbHexString,tinycolor.prototype.rgb=tinycolor.prototype.toRgbString,tinycolor.prototype.prgb=tinycolor.prototype.toPercentageRgbString,tinycolor.fromRatio=function(a,b){if("object"==typeof a){var c={};for(var d in a)a.hasOwnProperty(d)&&(c[d]="a"===d?a[d]:G(a[d]));a=c}return tinycolor(a,b)},tinycolor.equals=function(a,b){return!!(a&&b)&&tinycolor(a).toRgbString()==tinycolor(b).toRgbString()},tinycolor.random=function(){return tinycolor.fromRatio({r:R(),g:R(),b:R()})};tinycolor.mix=function(a,b,c){return r(a,b,c)},tinycolor.isDarker=function(a,b){return a.isDarkerThan(b)},tinycolor.isLighter=function(a,b){return a.isLighterThan(b)},tinycolor.isWarmer=function(a,b){return a.isWarmerThan(b)},tinycolor.isCooler=function(a,b){return a.isCoolerThan(b)},tinycolor.readability=function(b,c){var d=tinycolor(b),e=tinycolor(c);return(a.max(d.getLuminance(),e.getLuminance())+.05)/(a.min(d.getLuminance(),e.getLuminance())+.05)},tinycolor.isReadable=function(a,b,c){var d,e,f=tinycolor.readability(a,b);switch(e=!1,d=L(c),d.level+d.size){case"AAsmall":case"AAAlarge":e=4.5<=f;break;case"AAlarge":e=3<=f;break;case"AAAsmall":e=7<=f;}return e},tinycolor.mostReadable=function(a,b,c){var d,e,f,g,h=null,j=0;c=c||{},e=c.includeFallbackColors,f=c.level,g=c.size;for(var k=0;k<b.length;k++)d=tinycolor.readability(a,b[k]),d>j&&(j=d,h=tinycolor(b[k]));return tinycolor.isReadable(a,h,{level:f,size:g})||!e?h:(c.includeFallbackColors=!1,tinycolor.mostReadable(a,["#fff","#000"],c))};var T=tinycolor.names={transparent:"fff0",aliceblue:"f0f8ff",antiquewhite:"faebd7",aqua:"0ff",aquamarine:"7fffd4",azure:"f0ffff",beige:"f5f5dc",bisque:"ffe4c4",black:"000",blanchedalmond:"ffebcd",blue:"00f",blueviolet:"8a2be2",brown:"a52a2a",burlywood:"deb887",burntsienna:"ea7e5d",cadetblue:"5f9ea0",chartreuse:"7fff00",chocolate:"d2691e",coral:"ff7f50",cornflowerblue:"6495ed",cornsilk:"fff8dc",crimson:"dc143c",cyan:"0ff",darkblue:"00008b",darkcyan:"008b8b",darkgoldenrod:"b8860b",darkgray:"a9a9a9",darkgreen:"006400",darkgrey:"a9a9a9",darkkhaki:"bdb76b",darkmagenta:"8b008b",darkolivegreen:"556b2f",darkorange:"ff8c00",darkorchid:"9932cc",darkred:"8b0000",darksalmon:"e9967a",darkseagreen:"8fbc8f",darkslateblue:"483d8b",darkslategray:"2f4f4f",darkslategrey:"2f4f4f",darkturquoise:"00ced1",darkviolet:"9400d3",deeppink:"ff1493",deepskyblue:"00bfff",dimgray:"696969",dimgrey:"696969",dodgerblue:"1e90ff",firebrick:"b22222",floralwhite:"fffaf0",forestgreen:"228b22",fuchsia:"f0f",gainsboro:"dcdcdc",ghostwhite:"f8f8ff",gold:"ffd700",goldenrod:"daa520",gray:"808080",green:"008000",greenyellow:"adff2f",grey:"808080",honeydew:"f0fff0",hotpink:"ff69b4",indianred:"cd5c5c",indigo:"4b0082",ivory:"fffff0",khaki:"f0e68c",lavender:"e6e6fa",lavenderblush:"fff0f5",lawngreen:"7cfc00",lemonchiffon:"fffacd",lightblue:"add8e6",lightcoral:"f08080",lightcyan:"e0ffff",lightgoldenrodyellow:"fafad2",lightgray:"d3d3d3",lightgreen:"90ee90",lightgrey:"d3d3d3",lightpink:"ffb6c1",lightsalmon:"ffa07a",lightseagreen:"20b2aa",lightskyblue:"87cefa",lightslategray:"789",lightslategrey:"789",lightsteelblue:"b0c4de",lightyellow:"ffffe0",lime:"0f0",limegreen:"32cd32",linen:"faf0e6",magenta:"f0f",maroon:"800000",mediumaquamarine:"66cdaa",mediumblue:"0000cd",mediumorchid:"ba55d3",mediumpurple:"9370db",mediumseagreen:"3cb371",mediumslateblue:"7b68ee",mediumspringgreen:"00fa9a",mediumturquoise:"48d1cc",mediumvioletred:"c71585",midnightblue:"191970",mintcream:"f5fffa",mistyrose:"ffe4e1",moccasin:"ffe4b5",navajowhite:"ffdead",navy:"000080",oldlace:"fdf5e6",olive:"808000",olivedrab:"6b8e23",orange:"ffa500",orangered:"ff4500",orchid:"da70d6",palegoldenrod:"eee8aa",palegreen:"98fb98",paleturquoise:"afeeee",palevioletred:"db7093",papayawhip:"ffefd5",peachpuff:"ffdab9",peru:"cd853f",pink:"ffc0cb",plum:"dda0dd",powderblue:"b0e0e6",purple:"800080",rebeccapurple:"663399",red:"f00",rosybrown:"bc8f8f",royalblue:"4169e1",saddlebrown:"8b4513",salmon:"fa8072",sandybrown:"f4a460",seagreen:"2e8b57",seashell:"fff5ee",sienna:"a0522d",silver:"c0c0c0",skyblue:"87ceeb",slateblue:"6a5acd",slategray:"708090",slategrey:"708090",snow:"fffafa",springgreen:"00ff7f",steelblue:"4682b4",tan:"d2b48c",teal:"008080",thistle:"d8bfd8",tomato:"ff6347",turquoise:"40e0d0",violet:"ee82ee",wheat:"f5deb3",white:"fff",whitesmoke:"f5f5f5",yellow:"ff0",yellowgreen:"9acd32"},U=tinycolor.hexNames=function b(a){var c={};for(var d in a)a.hasOwnProperty(d)&&(c[a[d]]=d);return c}(T),V=function(){var a="[-\\+]?\\d+%?",b="[-\\+]?\\d*\\.\\d+%?",c="(?:"+b+")|(?:"+"[-\\+]?\\d+%?"+")",d="[\\s|\\(]+("+c+")[,|\\s]+("+c+")[,|\\s]+("+c+")\\s*\\)?",e="[\\s|\\(]+("+c+")[,|\\s]+("+c+")[,|\\s]+("+c+")[,|\\s]+("+c+")\\s*\\)?";return{CSS_UNIT:new RegExp(c),rgb:new RegExp("rgb"+d),rgba:new RegExp("rgba"+e),hsl:new RegExp("hsl"+d),hsla:new RegExp("hsla"+e),hsv:new RegExp("hsv"+d),hsva:new RegExp("hsva"+e),hex3:/^#?([0-9a-fA-F]{1})([0-9a-fA-F]{1})([0-9a-fA-F]{1})$/,hex6:/^#?([0-9a-fA-F]{2})([0-9a-fA-F]{2})([0-9a-fA-F]{2})$/,hex4:/^#?([0-9a-fA-F]{1})([0-9a-fA-F]{1})([0-9a-fA-F]{1})([0-9a-fA-F]{1})$/,hex8:/^#?([0-9a-fA-F]{2})([0-9a-fA-F]{2})([0-9a-fA-F]{2})([0-9a-fA-F]{2})$/}}();Color=tinycolor})(Math);var Color,tinycolor;
@@ -0,0 +1 @@
+var Env=class a{constructor(a,b){if(Object.defineProperty(this,"varName",{value:a}),Object.defineProperty(this,"defVal",{value:b}),void 0===a||null===a){const a=Object.entries(Util.env());for(const[b,c]of a)this[b]=c}else this[a]=void 0===this.defVal||null==this.defVal?Util.env(this.varName)+"":Util.env(this.varName,this.defVal)}valueOf(){return this.isValid?this.isSet?void 0===this.defVal||null==this.defVal?Util.env(this.varName)+"":Util.env(this.varName,this.defVal):void 0:JSON.stringify(Util.env(),null,2)}toString(){return this.valueOf()}get name(){return this.varName}get value(){return this.valueOf()}get isValid(){return"undefined"!=typeof this.varName&&this.varName}get isSet(){return this.isValid&&Util.envIsSet(this.varName)}set(a){return this.isValid&&Util.envPut(this.varName,a)}unset(){return this.isValid&&Util.envUnset(this.varName)}entries(){return Object.entries(this)}names(){return Object.keys(this)}values(){return Object.values(this)}get iterator(){const a=Object.entries(this);var b=0;return{hasNext:function(){return b<a.length},next:function(){return this.hasNext()?a[b++]:null}}}*[Symbol.iterator](){const a=Object.entries(this);for(const b of a)yield b}static isSet(a){return Uril.isSet(a)}static value(a,b){return Util.env(a,b)}static set(a,b){return Util.envPut(a,b)}static unset(a){return Util.envUnset(a)}static get entries(){return Object.entries(Util.env())}static get names(){return Object.keys(Util.env())}static get values(){return Object.values(Util.env())}static get iterator(){return new a().iterator}static*[Symbol.iterator](){const a=Object.entries(Util.env());for(const b of a)yield b}};
@@ -0,0 +1 @@
+var Headers=class{constructor(a){var b=null;if(a instanceof XMLHttpRequest)b=a;else if(Array.isArray(a))a.forEach(function(a){this.append(a[0],a[1])},this);else if(a)for(const[b,c]of Object.entries(a))this.set(b,c);Object.defineProperty(this,"_xhr",{value:b}),Object.defineProperty(this,"_xhrParsed",{value:!1,writable:!0})}_normlName(a){if("string"!=typeof a&&(a+=""),/[^a-z0-9\-#$%&'*+.^_`|~!]/i.test(a)||""===a)throw new TypeError("Invalid character in header field name: \""+a+"\"");return a.toLowerCase()}_normlVal(a){return"string"!=typeof a&&(a+=""),a}append(a,b){a=this._normlName(a),this.hasOwnProperty(a)?this[a]+=", "+this._normlVal(b):this[a]=this._normlVal(b)}delete(a){this._xhr||delete this[this._normlName(a)]}get(a){return a=this._normlName(a),this._xhr?this._xhr.getResponseHeader(a):this.hasOwnProperty(a)?this[a]:null}has(a){return this._xhr?null!=this._xhr.getResponseHeader(a):this.hasOwnProperty(this._normlName(a))}set(a,b){this._xhr||(this[this._normlName(a)]=this._normlVal(b))}_checkXhrParse(){if(this._xhr&&!this._xhrParsed){if(this._xhr.headers)this._xhr.headers.forEach(a=>this.append(a[0],a[1]));else{var a=[];this._xhr.getAllResponseHeaders().split(/^(.+?):/gm).forEach((b,c)=>{c%2&&a.push(b)}),a.forEach(a=>this.append(a,this._xhr.getResponseHeader(a)))}this._xhrParsed=!0}}forEach(a,b){for(const[c,d]of this.entries())a.call(b,c,d,this)}keys(){return this._checkXhrParse(),Object.keys(this)}values(){return this._checkXhrParse(),Object.values(this)}entries(){return this._checkXhrParse(),Object.entries(this)}*[Symbol.iterator](){const a=this.entries();for(const b of a)yield b}},Response=class{constructor(a){if(!a||!(a instanceof XMLHttpRequest))throw new TypeError("Response initializer must be an XMLHttpRequest object.");Object.defineProperty(this,"_xhr",{value:a}),Object.defineProperty(this,"_headers",{value:new Headers(a)}),Object.defineProperty(this,"_bodyUsed",{value:!1,writable:!0}),Object.defineProperty(this,"async",{enumerable:!0,get(){return this._xhr.async}}),Object.defineProperty(this,"body",{enumerable:!0,get(){return this.bodyAs()}}),Object.defineProperty(this,"bodyUsed",{enumerable:!0,get(){return this._bodyUsed}}),Object.defineProperty(this,"headers",{enumerable:!0,get(){return this._headers}}),Object.defineProperty(this,"ok",{enumerable:!0,get(){return 2==(0|this._xhr.status/100)}}),Object.defineProperty(this,"redirected",{enumerable:!0,get(){return this._xhr.responseURL!=this._xhr.url}}),Object.defineProperty(this,"responseType",{enumerable:!0,get(){return this._xhr.responseType},set(a){this._xhr.responseType=a}}),Object.defineProperty(this,"status",{enumerable:!0,get(){return this._xhr.status}}),Object.defineProperty(this,"statusText",{enumerable:!0,get(){return this._xhr.statusText}}),Object.defineProperty(this,"url",{enumerable:!0,get(){return this._xhr.responseURL}}),Object.defineProperty(this,"xhr",{enumerable:!0,get(){return this._xhr}})}clone(){return new Response(this._xhr)}bodyAs(a=""){return this._xhr.responseType=a,this._xhr.response}text(){return this.async?this.textAsync():this.textSync()}textAsync(){return Promise.resolve(this._xhr.responseText)}textSync(){return this._xhr.responseText}json(){return this.async?this.jsonAsync():this.jsonSync()}jsonAsync(){return Promise.resolve(this.jsonSync())}jsonSync(){return this.bodyAs("json")}arrayBuffer(){return this.buffer()}buffer(){return this.async?this.bufferAsync():this.bufferSync()}bufferAsync(){return Promise.resolve(this.bufferSync())}bufferSync(){return this.bodyAs("arraybuffer")}base64(){return this.async?this.base64Async():this.base64Sync()}base64Async(){return Promise.resolve(this.base64Sync())}base64Sync(){return this.bufferSync().toBase64()}xml(){return this.async?this.xmlAsync():this.xmlSync()}xmlAsync(){return Promise.resolve(this.xmlSync())}xmlSync(){return this.bodyAs("document")}blob(){throw TypeError("Blob type not supported.")}},Request=function(a,b=""){return this instanceof Request?(this.async=!0,this.body=null,this.credentials="include",this.headers=new Headers,this.method="GET",this.noThrow=!1,this.onprogress=null,this.redirect="no-less-safe",this.rejectOnError=!1,this.responseType="",this.signal=null,this.timeout=30000,this.url=b,this.xhr=null,this.error=null,("string"==typeof a||a instanceof URL)&&(a={url:a}),Object.assign(this,Request.GlobalDefaults,a)):new Request(a,b)};Request.GlobalDefaults={},Request.prototype._fetch=function(){return Request._fetchSetupXhr(this),this.async?Net.fetchAsync(this):Net.fetchSync(this)},Request.prototype.get=function(){return this.method="GET",this._fetch()},Request.prototype.head=function(){return this.method="HEAD",this._fetch()},Request.prototype.post=function(a){return this.method="POST",this.body=a,this._fetch()},Request.prototype.put=function(a){return this.method="PUT",this.body=a,this._fetch()},Request._fetchSetupOptions=function(a,b){return a instanceof Request?b&&(a.url=b):a=new Request(a,b),a},Request._fetchSetupXhr=function(a){try{if(!a.url)throw new ReferenceError("A valid URL is required before any network operation.");if(!a.method)throw new ReferenceError("A valid HTTP method is required before any network operation.");if(!a.xhr)a.xhr=new XMLHttpRequest;else if(!(a.xhr instanceof XMLHttpRequest))throw new ReferenceError("A valid XMLHttpRequest object is required when provided in 'options' object.");if(a.xhr.readyState>XMLHttpRequest.OPENED)throw new ReferenceError("An XMLHttpRequest object cannot be reused after send() method.");a.xhr.readyState<XMLHttpRequest.OPENED&&a.xhr.open(a.method,a.url,a.async),a.headers instanceof Headers||(a.headers=new Headers(a.headers));for(const[b,c]of a.headers)a.xhr.setRequestHeader(b,c);a.xhr.timeout=a.timeout,a.xhr.responseType=a.responseType,a.xhr.withCredentials="include"===a.credentials,a.xhr.hasOwnProperty("redirect")&&(a.xhr.redirect=a.redirect)}catch(b){console.error(b),a.error=b}},function(){"use strict";function a(a){return new Promise((b,c)=>{function d(){return new Response(a.xhr)}function e(a,b,c){let e=new DOMException(a,b,c);return e.response=d(),e}return a instanceof Request?a.xhr instanceof XMLHttpRequest?void(a.xhr.onload=()=>{a.rejectOnError&&2!=(0|a.xhr.status/100)?c(e(`Server responded with status code ${a.xhr.status}`,"NetworkError",DOMException.NETWORK_ERR)):b(d())},a.xhr.onerror=()=>{c(e("Request network error","NetworkError",DOMException.NETWORK_ERR))},a.xhr.ontimeout=()=>{c(e("Request timed out","TimeoutError",DOMException.TIMEOUT_ERR))},a.xhr.onabort=()=>{c(e("Request aborted","AbortError",DOMException.ABORT_ERR))},"function"==typeof a.onprogress&&(a.xhr.onprogress=a.onprogress),a.signal&&"function"==typeof a.signal.onabort&&a.signal.abort.connect(a.xhr,a.xhr.abort),a.xhr.send(a.body)):void c(a.error||new ReferenceError("A valid XMLHttpRequest object is required in Request argument.")):void c(new ReferenceError("First argument to fetchAsync() must be a Request object."))})}Net={fetch:function(b,c={}){return c=Request._fetchSetupOptions(c,b),c.async=!0,Request._fetchSetupXhr(c),a(c)},request:function(a,b={}){return b=Request._fetchSetupOptions(b,a),b.async=!1,b},fetchSync:function(a){function b(){return new Response(a.xhr)}function c(a,c,d){let e=new DOMException(a,c,d);return e.response=b(),e}if(!(a instanceof Request)){if(a.noThrow)return;throw new ReferenceError("First argument to fetchSync() must be a Request object.")}if(!(a.xhr instanceof XMLHttpRequest)){if(a.noThrow)return;throw a.error||new ReferenceError("A valid XMLHttpRequest object is required in Request argument.")}let d=0;if(a.xhr.onload=()=>{a.rejectOnError&&2!=(0|a.xhr.status/100)||(d=1)},a.xhr.ontimeout=()=>{d=2},a.xhr.onabort=()=>{d=3},"function"==typeof a.onprogress&&(a.xhr.onprogress=a.onprogress),a.signal&&"function"==typeof a.signal.onabort&&a.signal.abort.connect(a.xhr,a.xhr.abort),a.xhr.send(a.body),1==d||a.noThrow)return b();if(2==d)throw c("Request timed out","TimeoutError",DOMException.TIMEOUT_ERR);if(3==d)throw c("Request aborted","AbortError",DOMException.ABORT_ERR);throw c("Request network error","NetworkError",DOMException.NETWORK_ERR)},fetchAsync:a},GlobalRequestDefaults=Request.GlobalDefaults}();var Net,GlobalRequestDefaults;
@@ -1,13 +1,8 @@
 
 ArrayBuffer.fromBase64=function(a){return Util.fromBase64(a)},ArrayBuffer.prototype.toBase64=function(){return Util.toBase64(this)},ArrayBuffer.prototype.toHex=function(a){return Util.baToHex(this,a||0)};
-(function(a){"use strict";function b(b){var d={r:0,g:0,b:0},f=1,h=null,i=null,j=null,k=!1,m=!1;return"string"==typeof b&&(b=K(b)),"object"==typeof b&&(J(b.r)&&J(b.g)&&J(b.b)?(d=c(b.r,b.g,b.b),k=!0,m="%"===(b.r+"").substr(-1)?"prgb":"rgb"):J(b.h)&&J(b.s)&&(h=G(b.s),J(b.v)?(i=G(b.v),d=g(b.h,h,i),k=!0,m="hsv"):J(b.l)&&(j=G(b.l),d=e(b.h,h,j),k=!0,m="hsl")),b.hasOwnProperty("a")&&(f=b.a)),f=z(f),{ok:k,format:b.format||m,r:P(255,Q(d.r,0)),g:P(255,Q(d.g,0)),b:P(255,Q(d.b,0)),a:f}}function c(a,c,d){return{r:255*A(a,255),g:255*A(c,255),b:255*A(d,255)}}function d(a,c,e){a=A(a,255),c=A(c,255),e=A(e,255);var f,i,j=Q(a,c,e),k=P(a,c,e),m=(j+k)/2;if(j==k)f=i=0;else{var l=j-k;i=.5<m?l/(2-j-k):l/(j+k);j===a?f=(c-e)/l+(c<e?6:0):j===c?f=(e-a)/l+2:j===e?f=(a-c)/l+4:void 0;f/=6}return{h:f,s:i,l:m}}function e(a,c,d){function e(a,b,c){return 0>c&&(c+=1),1<c&&(c-=1),c<1/6?a+6*(b-a)*c:c<1/2?b:c<2/3?a+6*((b-a)*(2/3-c)):a}var f,i,j;if(a=A(a,360),c=A(c,100),d=A(d,100),0===c)f=i=j=d;else{var k=.5>d?d*(1+c):d+c-d*c,m=2*d-k;f=e(m,k,a+1/3),i=e(m,k,a),j=e(m,k,a-1/3)}return{r:255*f,g:255*i,b:255*j}}function f(a,c,e){a=A(a,255),c=A(c,255),e=A(e,255);var f,i,j=Q(a,c,e),k=P(a,c,e),l=j,m=j-k;return i=0===j?0:m/j,j==k?f=0:(j===a?f=(c-e)/m+(c<e?6:0):j===c?f=(e-a)/m+2:j===e?f=(a-c)/m+4:void 0,f/=6),{h:f,s:i,v:l}}function g(c,d,e){c=6*A(c,360),d=A(d,100),e=A(e,100);var j=a.floor(c),i=c-j,f=e*(1-d),k=e*(1-i*d),l=e*(1-(1-i)*d),m=j%6,n=[e,k,f,f,l,e][m],o=[l,e,e,k,f,f][m],g=[f,f,l,e,e,k][m];return{r:255*n,g:255*o,b:255*g}}function h(a,c,d,b){var e=[F(O(a).toString(16)),F(O(c).toString(16)),F(O(d).toString(16))];return b&&e[0].charAt(0)==e[0].charAt(1)&&e[1].charAt(0)==e[1].charAt(1)&&e[2].charAt(0)==e[2].charAt(1)?e[0].charAt(0)+e[1].charAt(0)+e[2].charAt(0):e.join("")}function i(c,d,e,b,a){var f=[F(O(c).toString(16)),F(O(d).toString(16)),F(O(e).toString(16)),F(H(b))];return a&&f[0].charAt(0)==f[0].charAt(1)&&f[1].charAt(0)==f[1].charAt(1)&&f[2].charAt(0)==f[2].charAt(1)&&f[3].charAt(0)==f[3].charAt(1)?f[0].charAt(0)+f[1].charAt(0)+f[2].charAt(0)+f[3].charAt(0):f.join("")}function j(c,d,e,b){var a=[F(H(b)),F(O(c).toString(16)),F(O(d).toString(16)),F(O(e).toString(16))];return a.join("")}function k(a,b){b=0===b?0:b||10;var c=tinycolor(a).toHsl();return c.s-=b/100,c.s=B(c.s),tinycolor(c)}function l(a,b){b=0===b?0:b||10;var c=tinycolor(a).toHsl();return c.s+=b/100,c.s=B(c.s),tinycolor(c)}function m(a){return tinycolor(a).desaturate(100)}function n(a,b){b=0===b?0:b||10;var c=tinycolor(a).toHsl();return c.l+=b/100,c.l=B(c.l),tinycolor(c)}function o(a,b){b=0===b?0:b||10;var c=tinycolor(a).toRgb();return c.r=Q(0,P(255,c.r-O(255*-(b/100)))),c.g=Q(0,P(255,c.g-O(255*-(b/100)))),c.b=Q(0,P(255,c.b-O(255*-(b/100)))),tinycolor(c)}function p(a,b){b=0===b?0:b||10;var c=tinycolor(a).toHsl();return c.l-=b/100,c.l=B(c.l),tinycolor(c)}function q(a,b){var c=tinycolor(a).toHsl(),d=(c.h+b)%360;return c.h=0>d?360+d:d,tinycolor(c)}function r(a,b,c){c=0===c?0:c||50;var d=tinycolor(a).toRgb(),e=tinycolor(b).toRgb(),f=c/100,g={r:(e.r-d.r)*f+d.r,g:(e.g-d.g)*f+d.g,b:(e.b-d.b)*f+d.b,a:(e.a-d.a)*f+d.a};return tinycolor(g)}function s(a,b){return b=0===b?0:b||10,r(a,"white",b)}function t(a,b){return b=0===b?0:b||10,r(a,"black",b)}function u(a){var b=tinycolor(a).toHsl();return b.h=(b.h+180)%360,tinycolor(b)}function v(a,b){var c=tinycolor(a).toHsl(),d=c.h;b=b&&0<b?b:5;for(var e=[tinycolor(a)],f=360/b,g=1;g<b;g++)e.push(tinycolor({h:(d+g*f)%360,s:c.s,l:c.l,a:a._a}));return e}function w(a){var b=tinycolor(a).toHsl(),c=b.h;return[tinycolor(a),tinycolor({h:(c+72)%360,s:b.s,l:b.l,a:a._a}),tinycolor({h:(c+216)%360,s:b.s,l:b.l,a:a._a})]}function x(a,b,c){b=b&&0<b?b:6,c=c&&0<c?c:30;var d=tinycolor(a).toHsl(),e=360/c,f=[tinycolor(a)];for(d.h=(d.h-(e*b>>1)+720)%360;--b;)d.h=(d.h+e)%360,f.push(tinycolor(d));return f}function y(b,c){c=c&&0<c?c:6;for(var d=tinycolor(b).toHsv(),e=d.h,f=d.s,g=d.v,h=b._a,a=[],i=1/c;c--;)a.push(tinycolor({h:e,s:f,v:g,a:h})),g=(g+i)%1;return a}function z(b){return b=parseFloat(b),(isNaN(b)||0>b||1<b)&&(b=1),b}function A(b,c){D(b)&&(b="100%");var d=E(b);return b=360===c?b:P(c,Q(0,parseFloat(b))),d&&(b=parseInt(b*c,10)/100),1e-6>a.abs(b-c)?1:360===c?(0>b?b%c+c:b%c)/360:b%c/parseFloat(c)}function B(a){return P(1,Q(0,a))}function C(a){return parseInt(a,16)}function D(a){return"string"==typeof a&&-1!=a.indexOf(".")&&1===parseFloat(a)}function E(a){return"string"==typeof a&&-1!=a.indexOf("%")}function F(a){return 1==a.length?"0"+a:""+a}function G(a){return 1>=a&&(a=100*a+"%"),a}function H(b){return a.round(255*parseFloat(b)).toString(16)}function I(a){return C(a)/255}function J(a){return!!V.CSS_UNIT.exec(a)}function K(a){a=a.replace(M,"").replace(N,"").toLowerCase();var b=!1;T[a]&&(a=T[a],b=!0);var c;return(c=V.rgb.exec(a))?{r:c[1],g:c[2],b:c[3]}:(c=V.rgba.exec(a))?{r:c[1],g:c[2],b:c[3],a:c[4]}:(c=V.hsl.exec(a))?{h:c[1],s:c[2],l:c[3]}:(c=V.hsla.exec(a))?{h:c[1],s:c[2],l:c[3],a:c[4]}:(c=V.hsv.exec(a))?{h:c[1],s:c[2],v:c[3]}:(c=V.hsva.exec(a))?{h:c[1],s:c[2],v:c[3],a:c[4]}:(c=V.hex8.exec(a))?{r:C(c[1]),g:C(c[2]),b:C(c[3]),a:I(c[4]),format:b?"name":"hex8"}:(c=V.hex6.exec(a))?{r:C(c[1]),g:C(c[2]),b:C(c[3]),format:b?"name":"hex"}:(c=V.hex4.exec(a))?{r:C(c[1]+""+c[1]),g:C(c[2]+""+c[2]),b:C(c[3]+""+c[3]),a:I(c[4]+""+c[4]),format:b?"name":"hex8"}:!!(c=V.hex3.exec(a))&&{r:C(c[1]+""+c[1]),g:C(c[2]+""+c[2]),b:C(c[3]+""+c[3]),format:b?"name":"hex"}}function L(a){var b,c;return a=a||{level:"AA",size:"small"},b=(a.level||"AA").toUpperCase(),c=(a.size||"small").toLowerCase(),"AA"!==b&&"AAA"!==b&&(b="AA"),"small"!==c&&"large"!==c&&(c="small"),{level:b,size:c}}var M=/^\s+/,N=/\s+$/,O=a.round,P=a.min,Q=a.max,R=a.random,S=a.abs;tinycolor=function(a,c){if(a=a?a:"",c=c||{},a instanceof tinycolor)return a;if(!(this instanceof tinycolor))return new tinycolor(a,c);var d=b(a);this._originalInput=a,this._r=d.r,this._g=d.g,this._b=d.b,this._a=d.a,this._roundA=O(100*this._a)/100,this._format=c.format||d.format,this._gradientType=c.gradientType,1>this._r&&(this._r=O(this._r)),1>this._g&&(this._g=O(this._g)),1>this._b&&(this._b=O(this._b)),this._ok=d.ok},tinycolor.prototype={isValid:function(){return this._ok},isDark:function(){return 128>this.getBrightness()},isLight:function(){return!this.isDark()},isWarm:function(){return this._r>this._b},isCool:function(){return!this.isWarm()},getOriginalInput:function(){return this._originalInput},getFormat:function(){return this._format},getAlpha:function(){return this._a},getBrightness:function(){var a=this.toRgb();return(299*a.r+587*a.g+114*a.b)/1e3},getLuminance:function(){var b,c,d,e,f,g,h=this.toRgb();return b=h.r/255,c=h.g/255,d=h.b/255,e=.03928>=b?b/12.92:a.pow((b+.055)/1.055,2.4),f=.03928>=c?c/12.92:a.pow((c+.055)/1.055,2.4),g=.03928>=d?d/12.92:a.pow((d+.055)/1.055,2.4),.2126*e+.7152*f+.0722*g},getSaturation:function(){var a=this.toRgb(),b=Q(a.r,a.g,a.b)/255,c=P(a.r,a.g,a.b)/255,d=this.getLuminance();return 1===d?0:(b-c)/(1-S(2*d-1))},setAlpha:function(a){return this._a=z(a),this._roundA=O(100*this._a)/100,this},toHsv:function(){var a=f(this._r,this._g,this._b);return{h:360*a.h,s:a.s,v:a.v,a:this._a}},toHsvString:function(){var a=f(this._r,this._g,this._b),b=O(360*a.h),c=O(100*a.s),d=O(100*a.v);return 1==this._a?"hsv("+b+", "+c+"%, "+d+"%)":"hsva("+b+", "+c+"%, "+d+"%, "+this._roundA+")"},toHsl:function(){var a=d(this._r,this._g,this._b);return{h:360*a.h,s:a.s,l:a.l,a:this._a}},toHslString:function(){var a=d(this._r,this._g,this._b),b=O(360*a.h),c=O(100*a.s),e=O(100*a.l);return 1==this._a?"hsl("+b+", "+c+"%, "+e+"%)":"hsla("+b+", "+c+"%, "+e+"%, "+this._roundA+")"},toHex:function(a){return h(this._r,this._g,this._b,a)},toHexString:function(a){return"#"+this.toHex(a)},toHex8:function(a){return i(this._r,this._g,this._b,this._a,a)},toHex8String:function(a){return"#"+this.toHex8(a)},toArgbHex:function(){return j(this._r,this._g,this._b,this._a)},toArgbHexString:function(){return"#"+this.toArgbHex()},toRgb:function(){return{r:O(this._r),g:O(this._g),b:O(this._b),a:this._a}},toRgbString:function(){return 1==this._a?"rgb("+O(this._r)+", "+O(this._g)+", "+O(this._b)+")":"rgba("+O(this._r)+", "+O(this._g)+", "+O(this._b)+", "+this._roundA+")"},toPercentageRgb:function(){return{r:O(100*A(this._r,255))+"%",g:O(100*A(this._g,255))+"%",b:O(100*A(this._b,255))+"%",a:this._a}},toPercentageRgbString:function(){return 1==this._a?"rgb("+O(100*A(this._r,255))+"%, "+O(100*A(this._g,255))+"%, "+O(100*A(this._b,255))+"%)":"rgba("+O(100*A(this._r,255))+"%, "+O(100*A(this._g,255))+"%, "+O(100*A(this._b,255))+"%, "+this._roundA+")"},toName:function(){return 0===this._a&&255===this._r&&255===this._g&&255===this._b?"transparent":!(1>this._a)&&(U[h(this._r,this._g,this._b,!0)]||!1)},toFilter:function(a){var b="#"+j(this._r,this._g,this._b,this._a),c=b,d=this._gradientType?"GradientType = 1, ":"";if(a){var e=tinycolor(a);c="#"+j(e._r,e._g,e._b,e._a)}return"progid:DXImageTransform.Microsoft.gradient("+d+"startColorstr="+b+",endColorstr="+c+")"},toString:function(a){var b=!!a;a=a||this._format;var c=1>this._a&&0<=this._a,d=!b&&c&&("hex"===a||"hex6"===a||"hex3"===a||"hex4"===a||"hex8"===a||"name"===a);if(d)return"name"===a&&0===this._a?this.toName():this.toRgbString();return"rgb"===a?this.toRgbString():"prgb"===a?this.toPercentageRgbString():"hex3"===a?this.toHexString(!0):"hex4"===a?this.toHex8String(!0):"hex8"===a||"rgba"===a?this.toHex8String():"hex8a"===a||"argb"===a?this.toArgbHexString():"name"===a?this.toName()||this.toHexString():"hsl"===a?this.toHslString():"hsv"===a?this.toHsvString():this.toHexString()},clone:function(){return tinycolor(this.toString())},_applyModification:function(a,b){var c=a.apply(null,[this].concat([].slice.call(b)));return this._r=c._r,this._g=c._g,this._b=c._b,this.setAlpha(c._a),this},lighten:function(){return this._applyModification(n,arguments)},brighten:function(){return this._applyModification(o,arguments)},darken:function(){return this._applyModification(p,arguments)},desaturate:function(){return this._applyModification(k,arguments)},saturate:function(){return this._applyModification(l,arguments)},greyscale:function(){return this._applyModification(m,arguments)},spin:function(){return this._applyModification(q,arguments)},mixWith:function(){return this._applyModification(r,arguments)},tint:function(){return this._applyModification(s,arguments)},shade:function(){return this._applyModification(t,arguments)},_applyCombination:function(a,b){return a.apply(null,[this].concat([].slice.call(b)))},analogous:function(){return this._applyCombination(x,arguments)},complement:function(){return this._applyCombination(u,arguments)},monochromatic:function(){return this._applyCombination(y,arguments)},splitcomplement:function(){return this._applyCombination(w,arguments)},triad:function(){return this._applyCombination(v,[3])},tetrad:function(){return this._applyCombination(v,[4])},polyad:function(a){return this._applyCombination(v,[a])},isDarkerThan:function(a){return this.getBrightness()<a.getBrightness()},isLighterThan:function(a){return!this.isDarker(a)},isWarmerThan:function(a){return!!(this._r>a._r)||!(this._r!=a._r)&&this._b+this._g<a._b+a._g},isCoolerThan:function(a){return!this.isWarmer(a)}},tinycolor.prototype.originalInput=tinycolor.prototype.getOriginalInput,tinycolor.prototype.format=tinycolor.prototype.getFormat,tinycolor.prototype.alpha=tinycolor.prototype.getAlpha,tinycolor.prototype.brightness=tinycolor.prototype.getBrightness,tinycolor.prototype.luminance=tinycolor.prototype.getLuminance,tinycolor.prototype.saturation=tinycolor.prototype.getSaturation,tinycolor.prototype.hsv=tinycolor.prototype.toHsvString,tinycolor.prototype.hsl=tinycolor.prototype.toHslString,tinycolor.prototype.hex=tinycolor.prototype.toHexString,tinycolor.prototype.rgba=tinycolor.prototype.toHex8String,tinycolor.prototype.argb=tinycolor.prototype.toArgbHexString,tinycolor.prototype.tpcolor=tinycolor.prototype.toArgbHexString,tinycolor.prototype.rgb=tinycolor.prototype.toRgbString,tinycolor.prototype.prgb=tinycolor.prototype.toPercentageRgbString,tinycolor.fromRatio=function(a,b){if("object"==typeof a){var c={};for(var d in a)a.hasOwnProperty(d)&&(c[d]="a"===d?a[d]:G(a[d]));a=c}return tinycolor(a,b)},tinycolor.equals=function(a,b){return!!(a&&b)&&tinycolor(a).toRgbString()==tinycolor(b).toRgbString()},tinycolor.random=function(){return tinycolor.fromRatio({r:R(),g:R(),b:R()})};tinycolor.mix=function(a,b,c){return r(a,b,c)},tinycolor.isDarker=function(a,b){return a.isDarkerThan(b)},tinycolor.isLighter=function(a,b){return a.isLighterThan(b)},tinycolor.isWarmer=function(a,b){return a.isWarmerThan(b)},tinycolor.isCooler=function(a,b){return a.isCoolerThan(b)},tinycolor.readability=function(b,c){var d=tinycolor(b),e=tinycolor(c);return(a.max(d.getLuminance(),e.getLuminance())+.05)/(a.min(d.getLuminance(),e.getLuminance())+.05)},tinycolor.isReadable=function(a,b,c){var d,e,f=tinycolor.readability(a,b);switch(e=!1,d=L(c),d.level+d.size){case"AAsmall":case"AAAlarge":e=4.5<=f;break;case"AAlarge":e=3<=f;break;case"AAAsmall":e=7<=f;}return e},tinycolor.mostReadable=function(a,b,c){var d,e,f,g,h=null,j=0;c=c||{},e=c.includeFallbackColors,f=c.level,g=c.size;for(var k=0;k<b.length;k++)d=tinycolor.readability(a,b[k]),d>j&&(j=d,h=tinycolor(b[k]));return tinycolor.isReadable(a,h,{level:f,size:g})||!e?h:(c.includeFallbackColors=!1,tinycolor.mostReadable(a,["#fff","#000"],c))};var T=tinycolor.names={transparent:"fff0",aliceblue:"f0f8ff",antiquewhite:"faebd7",aqua:"0ff",aquamarine:"7fffd4",azure:"f0ffff",beige:"f5f5dc",bisque:"ffe4c4",black:"000",blanchedalmond:"ffebcd",blue:"00f",blueviolet:"8a2be2",brown:"a52a2a",burlywood:"deb887",burntsienna:"ea7e5d",cadetblue:"5f9ea0",chartreuse:"7fff00",chocolate:"d2691e",coral:"ff7f50",cornflowerblue:"6495ed",cornsilk:"fff8dc",crimson:"dc143c",cyan:"0ff",darkblue:"00008b",darkcyan:"008b8b",darkgoldenrod:"b8860b",darkgray:"a9a9a9",darkgreen:"006400",darkgrey:"a9a9a9",darkkhaki:"bdb76b",darkmagenta:"8b008b",darkolivegreen:"556b2f",darkorange:"ff8c00",darkorchid:"9932cc",darkred:"8b0000",darksalmon:"e9967a",darkseagreen:"8fbc8f",darkslateblue:"483d8b",darkslategray:"2f4f4f",darkslategrey:"2f4f4f",darkturquoise:"00ced1",darkviolet:"9400d3",deeppink:"ff1493",deepskyblue:"00bfff",dimgray:"696969",dimgrey:"696969",dodgerblue:"1e90ff",firebrick:"b22222",floralwhite:"fffaf0",forestgreen:"228b22",fuchsia:"f0f",gainsboro:"dcdcdc",ghostwhite:"f8f8ff",gold:"ffd700",goldenrod:"daa520",gray:"808080",green:"008000",greenyellow:"adff2f",grey:"808080",honeydew:"f0fff0",hotpink:"ff69b4",indianred:"cd5c5c",indigo:"4b0082",ivory:"fffff0",khaki:"f0e68c",lavender:"e6e6fa",lavenderblush:"fff0f5",lawngreen:"7cfc00",lemonchiffon:"fffacd",lightblue:"add8e6",lightcoral:"f08080",lightcyan:"e0ffff",lightgoldenrodyellow:"fafad2",lightgray:"d3d3d3",lightgreen:"90ee90",lightgrey:"d3d3d3",lightpink:"ffb6c1",lightsalmon:"ffa07a",lightseagreen:"20b2aa",lightskyblue:"87cefa",lightslategray:"789",lightslategrey:"789",lightsteelblue:"b0c4de",lightyellow:"ffffe0",lime:"0f0",limegreen:"32cd32",linen:"faf0e6",magenta:"f0f",maroon:"800000",mediumaquamarine:"66cdaa",mediumblue:"0000cd",mediumorchid:"ba55d3",mediumpurple:"9370db",mediumseagreen:"3cb371",mediumslateblue:"7b68ee",mediumspringgreen:"00fa9a",mediumturquoise:"48d1cc",mediumvioletred:"c71585",midnightblue:"191970",mintcream:"f5fffa",mistyrose:"ffe4e1",moccasin:"ffe4b5",navajowhite:"ffdead",navy:"000080",oldlace:"fdf5e6",olive:"808000",olivedrab:"6b8e23",orange:"ffa500",orangered:"ff4500",orchid:"da70d6",palegoldenrod:"eee8aa",palegreen:"98fb98",paleturquoise:"afeeee",palevioletred:"db7093",papayawhip:"ffefd5",peachpuff:"ffdab9",peru:"cd853f",pink:"ffc0cb",plum:"dda0dd",powderblue:"b0e0e6",purple:"800080",rebeccapurple:"663399",red:"f00",rosybrown:"bc8f8f",royalblue:"4169e1",saddlebrown:"8b4513",salmon:"fa8072",sandybrown:"f4a460",seagreen:"2e8b57",seashell:"fff5ee",sienna:"a0522d",silver:"c0c0c0",skyblue:"87ceeb",slateblue:"6a5acd",slategray:"708090",slategrey:"708090",snow:"fffafa",springgreen:"00ff7f",steelblue:"4682b4",tan:"d2b48c",teal:"008080",thistle:"d8bfd8",tomato:"ff6347",turquoise:"40e0d0",violet:"ee82ee",wheat:"f5deb3",white:"fff",whitesmoke:"f5f5f5",yellow:"ff0",yellowgreen:"9acd32"},U=tinycolor.hexNames=function b(a){var c={};for(var d in a)a.hasOwnProperty(d)&&(c[a[d]]=d);return c}(T),V=function(){var a="[-\\+]?\\d+%?",b="[-\\+]?\\d*\\.\\d+%?",c="(?:"+b+")|(?:"+"[-\\+]?\\d+%?"+")",d="[\\s|\\(]+("+c+")[,|\\s]+("+c+")[,|\\s]+("+c+")\\s*\\)?",e="[\\s|\\(]+("+c+")[,|\\s]+("+c+")[,|\\s]+("+c+")[,|\\s]+("+c+")\\s*\\)?";return{CSS_UNIT:new RegExp(c),rgb:new RegExp("rgb"+d),rgba:new RegExp("rgba"+e),hsl:new RegExp("hsl"+d),hsla:new RegExp("hsla"+e),hsv:new RegExp("hsv"+d),hsva:new RegExp("hsva"+e),hex3:/^#?([0-9a-fA-F]{1})([0-9a-fA-F]{1})([0-9a-fA-F]{1})$/,hex6:/^#?([0-9a-fA-F]{2})([0-9a-fA-F]{2})([0-9a-fA-F]{2})$/,hex4:/^#?([0-9a-fA-F]{1})([0-9a-fA-F]{1})([0-9a-fA-F]{1})([0-9a-fA-F]{1})$/,hex8:/^#?([0-9a-fA-F]{2})([0-9a-fA-F]{2})([0-9a-fA-F]{2})([0-9a-fA-F]{2})$/}}();Color=tinycolor})(Math);var Color,tinycolor;
 Date.prototype.clone=function(){return new Date(+this)},Date.prototype.addSeconds=function(a){if(!a)return this;let b=this;return b.setSeconds(b.getSeconds()+a),b},Date.prototype.addMinutes=function(a){if(!a)return this;let b=this;return b.setMinutes(b.getMinutes()+a),b},Date.prototype.addHours=function(a){if(!a)return this;let b=this;return b.setHours(b.getHours()+a),b},Date.prototype.addDays=function(a){if(!a)return this;let b=this;return b.setDate(b.getDate()+a),b},Date.prototype.addMonths=function(a){if(!a)return this;let b=this;return b.setMonth(b.getMonth()+a),b},Date.prototype.addYears=function(a){if(!a)return this;let b=this;return b.setYear(b.getYear()+a),b},Date.prototype.compareToDate=function(a){return a?this.getFullYear()===date.getFullYear()?this.getMonth()===date.getMonth()?this.getDate()===date.getDate()?0:this.getDate()>date.getDate()?-1:1:this.getMonth()>date.getMonth()?-1:1:this.getFullYear()>date.getFullYear()?-1:1:1};
-var Env=class a{constructor(a,b){if(Object.defineProperty(this,"varName",{value:a}),Object.defineProperty(this,"defVal",{value:b}),void 0===a||null===a){const a=Object.entries(Util.env());for(const[b,c]of a)this[b]=c}else this[a]=void 0===this.defVal||null==this.defVal?Util.env(this.varName)+"":Util.env(this.varName,this.defVal)}valueOf(){return this.isValid?this.isSet?void 0===this.defVal||null==this.defVal?Util.env(this.varName)+"":Util.env(this.varName,this.defVal):void 0:JSON.stringify(Util.env(),null,2)}toString(){return this.valueOf()}get name(){return this.varName}get value(){return this.valueOf()}get isValid(){return"undefined"!=typeof this.varName&&this.varName}get isSet(){return this.isValid&&Util.envIsSet(this.varName)}set(a){return this.isValid&&Util.envPut(this.varName,a)}unset(){return this.isValid&&Util.envUnset(this.varName)}entries(){return Object.entries(this)}names(){return Object.keys(this)}values(){return Object.values(this)}get iterator(){const a=Object.entries(this);var b=0;return{hasNext:function(){return b<a.length},next:function(){return this.hasNext()?a[b++]:null}}}*[Symbol.iterator](){const a=Object.entries(this);for(const b of a)yield b}static isSet(a){return Uril.isSet(a)}static value(a,b){return Util.env(a,b)}static set(a,b){return Util.envPut(a,b)}static unset(a){return Util.envUnset(a)}static get entries(){return Object.entries(Util.env())}static get names(){return Object.keys(Util.env())}static get values(){return Object.values(Util.env())}static get iterator(){return new a().iterator}static*[Symbol.iterator](){const a=Object.entries(Util.env());for(const b of a)yield b}};
-var Headers=class{constructor(a){var b=null;if(a instanceof XMLHttpRequest)b=a;else if(Array.isArray(a))a.forEach(function(a){this.append(a[0],a[1])},this);else if(a)for(const[b,c]of Object.entries(a))this.set(b,c);Object.defineProperty(this,"_xhr",{value:b}),Object.defineProperty(this,"_xhrParsed",{value:!1,writable:!0})}_normlName(a){if("string"!=typeof a&&(a+=""),/[^a-z0-9\-#$%&'*+.^_`|~!]/i.test(a)||""===a)throw new TypeError("Invalid character in header field name: \""+a+"\"");return a.toLowerCase()}_normlVal(a){return"string"!=typeof a&&(a+=""),a}append(a,b){a=this._normlName(a),this.hasOwnProperty(a)?this[a]+=", "+this._normlVal(b):this[a]=this._normlVal(b)}delete(a){this._xhr||delete this[this._normlName(a)]}get(a){return a=this._normlName(a),this._xhr?this._xhr.getResponseHeader(a):this.hasOwnProperty(a)?this[a]:null}has(a){return this._xhr?null!=this._xhr.getResponseHeader(a):this.hasOwnProperty(this._normlName(a))}set(a,b){this._xhr||(this[this._normlName(a)]=this._normlVal(b))}_checkXhrParse(){if(this._xhr&&!this._xhrParsed){if(this._xhr.headers)this._xhr.headers.forEach(a=>this.append(a[0],a[1]));else{var a=[];this._xhr.getAllResponseHeaders().split(/^(.+?):/gm).forEach((b,c)=>{c%2&&a.push(b)}),a.forEach(a=>this.append(a,this._xhr.getResponseHeader(a)))}this._xhrParsed=!0}}forEach(a,b){for(const[c,d]of this.entries())a.call(b,c,d,this)}keys(){return this._checkXhrParse(),Object.keys(this)}values(){return this._checkXhrParse(),Object.values(this)}entries(){return this._checkXhrParse(),Object.entries(this)}*[Symbol.iterator](){const a=this.entries();for(const b of a)yield b}},Response=class{constructor(a){if(!a||!(a instanceof XMLHttpRequest))throw new TypeError("Response initializer must be an XMLHttpRequest object.");Object.defineProperty(this,"_xhr",{value:a}),Object.defineProperty(this,"_headers",{value:new Headers(a)}),Object.defineProperty(this,"_bodyUsed",{value:!1,writable:!0}),Object.defineProperty(this,"async",{enumerable:!0,get(){return this._xhr.async}}),Object.defineProperty(this,"body",{enumerable:!0,get(){return this.bodyAs()}}),Object.defineProperty(this,"bodyUsed",{enumerable:!0,get(){return this._bodyUsed}}),Object.defineProperty(this,"headers",{enumerable:!0,get(){return this._headers}}),Object.defineProperty(this,"ok",{enumerable:!0,get(){return 2==(0|this._xhr.status/100)}}),Object.defineProperty(this,"redirected",{enumerable:!0,get(){return this._xhr.responseURL!=this._xhr.url}}),Object.defineProperty(this,"responseType",{enumerable:!0,get(){return this._xhr.responseType},set(a){this._xhr.responseType=a}}),Object.defineProperty(this,"status",{enumerable:!0,get(){return this._xhr.status}}),Object.defineProperty(this,"statusText",{enumerable:!0,get(){return this._xhr.statusText}}),Object.defineProperty(this,"url",{enumerable:!0,get(){return this._xhr.responseURL}}),Object.defineProperty(this,"xhr",{enumerable:!0,get(){return this._xhr}})}clone(){return new Response(this._xhr)}bodyAs(a=""){return this._xhr.responseType=a,this._xhr.response}text(){return this.async?this.textAsync():this.textSync()}textAsync(){return Promise.resolve(this._xhr.responseText)}textSync(){return this._xhr.responseText}json(){return this.async?this.jsonAsync():this.jsonSync()}jsonAsync(){return Promise.resolve(this.jsonSync())}jsonSync(){return this.bodyAs("json")}arrayBuffer(){return this.buffer()}buffer(){return this.async?this.bufferAsync():this.bufferSync()}bufferAsync(){return Promise.resolve(this.bufferSync())}bufferSync(){return this.bodyAs("arraybuffer")}base64(){return this.async?this.base64Async():this.base64Sync()}base64Async(){return Promise.resolve(this.base64Sync())}base64Sync(){return this.bufferSync().toBase64()}xml(){return this.async?this.xmlAsync():this.xmlSync()}xmlAsync(){return Promise.resolve(this.xmlSync())}xmlSync(){return this.bodyAs("document")}blob(){throw TypeError("Blob type not supported.")}},Request=function(a,b=""){return this instanceof Request?(this.async=!0,this.body=null,this.credentials="include",this.headers=new Headers,this.method="GET",this.noThrow=!1,this.onprogress=null,this.redirect="no-less-safe",this.rejectOnError=!1,this.responseType="",this.signal=null,this.timeout=30000,this.url=b,this.xhr=null,this.error=null,("string"==typeof a||a instanceof URL)&&(a={url:a}),Object.assign(this,Request.GlobalDefaults,a)):new Request(a,b)};Request.GlobalDefaults={},Request.prototype._fetch=function(){return Request._fetchSetupXhr(this),this.async?Net.fetchAsync(this):Net.fetchSync(this)},Request.prototype.get=function(){return this.method="GET",this._fetch()},Request.prototype.head=function(){return this.method="HEAD",this._fetch()},Request.prototype.post=function(a){return this.method="POST",this.body=a,this._fetch()},Request.prototype.put=function(a){return this.method="PUT",this.body=a,this._fetch()},Request._fetchSetupOptions=function(a,b){return a instanceof Request?b&&(a.url=b):a=new Request(a,b),a},Request._fetchSetupXhr=function(a){try{if(!a.url)throw new ReferenceError("A valid URL is required before any network operation.");if(!a.method)throw new ReferenceError("A valid HTTP method is required before any network operation.");if(!a.xhr)a.xhr=new XMLHttpRequest;else if(!(a.xhr instanceof XMLHttpRequest))throw new ReferenceError("A valid XMLHttpRequest object is required when provided in 'options' object.");if(a.xhr.readyState>XMLHttpRequest.OPENED)throw new ReferenceError("An XMLHttpRequest object cannot be reused after send() method.");a.xhr.readyState<XMLHttpRequest.OPENED&&a.xhr.open(a.method,a.url,a.async),a.headers instanceof Headers||(a.headers=new Headers(a.headers));for(const[b,c]of a.headers)a.xhr.setRequestHeader(b,c);a.xhr.timeout=a.timeout,a.xhr.responseType=a.responseType,a.xhr.withCredentials="include"===a.credentials,a.xhr.hasOwnProperty("redirect")&&(a.xhr.redirect=a.redirect)}catch(b){console.error(b),a.error=b}},function(){"use strict";function a(a){return new Promise((b,c)=>{function d(){return new Response(a.xhr)}function e(a,b,c){let e=new DOMException(a,b,c);return e.response=d(),e}return a instanceof Request?a.xhr instanceof XMLHttpRequest?void(a.xhr.onload=()=>{a.rejectOnError&&2!=(0|a.xhr.status/100)?c(e(`Server responded with status code ${a.xhr.status}`,"NetworkError",DOMException.NETWORK_ERR)):b(d())},a.xhr.onerror=()=>{c(e("Request network error","NetworkError",DOMException.NETWORK_ERR))},a.xhr.ontimeout=()=>{c(e("Request timed out","TimeoutError",DOMException.TIMEOUT_ERR))},a.xhr.onabort=()=>{c(e("Request aborted","AbortError",DOMException.ABORT_ERR))},"function"==typeof a.onprogress&&(a.xhr.onprogress=a.onprogress),a.signal&&"function"==typeof a.signal.onabort&&a.signal.abort.connect(a.xhr,a.xhr.abort),a.xhr.send(a.body)):void c(a.error||new ReferenceError("A valid XMLHttpRequest object is required in Request argument.")):void c(new ReferenceError("First argument to fetchAsync() must be a Request object."))})}Net={fetch:function(b,c={}){return c=Request._fetchSetupOptions(c,b),c.async=!0,Request._fetchSetupXhr(c),a(c)},request:function(a,b={}){return b=Request._fetchSetupOptions(b,a),b.async=!1,b},fetchSync:function(a){function b(){return new Response(a.xhr)}function c(a,c,d){let e=new DOMException(a,c,d);return e.response=b(),e}if(!(a instanceof Request)){if(a.noThrow)return;throw new ReferenceError("First argument to fetchSync() must be a Request object.")}if(!(a.xhr instanceof XMLHttpRequest)){if(a.noThrow)return;throw a.error||new ReferenceError("A valid XMLHttpRequest object is required in Request argument.")}let d=0;if(a.xhr.onload=()=>{a.rejectOnError&&2!=(0|a.xhr.status/100)||(d=1)},a.xhr.ontimeout=()=>{d=2},a.xhr.onabort=()=>{d=3},"function"==typeof a.onprogress&&(a.xhr.onprogress=a.onprogress),a.signal&&"function"==typeof a.signal.onabort&&a.signal.abort.connect(a.xhr,a.xhr.abort),a.xhr.send(a.body),1==d||a.noThrow)return b();if(2==d)throw c("Request timed out","TimeoutError",DOMException.TIMEOUT_ERR);if(3==d)throw c("Request aborted","AbortError",DOMException.ABORT_ERR);throw c("Request network error","NetworkError",DOMException.NETWORK_ERR)},fetchAsync:a},GlobalRequestDefaults=Request.GlobalDefaults}();var Net,GlobalRequestDefaults;
 var setTimeout=Util.setTimeout,clearTimeout=Util.clearTimeout,setInterval=Util.setInterval,clearInterval=Util.clearInterval,clearAllTimers=Util.clearAllTimers,clearInstanceTimers=Util.clearInstanceTimers,btoa=Util.btoa,atob=Util.atob,hash=Util.hash,include=Util.include,require=Util.require,locale=Qt?Qt.locale:function(){},TP=TPAPI,registeredModules={clipboard:void 0};TPAPI.onconnectorIdsChanged=function(a,b=null){onEventHandler(TPAPI.connectorIdsChanged,a,b)},TPAPI.onbroadcastEvent=function(a,b=null){onEventHandler(TPAPI.broadcastEvent,a,b)},TPAPI.onmessageEvent=function(a,b=null){onEventHandler(TPAPI.messageEvent,a,b)};function onEventHandler(a,b,c){c&&"function"==typeof b?a.connect(c,b):a.connect(b)}Object.defineProperty(AbortController,Symbol.hasInstance,{configurable:!0,value(a){return"AbortSignal"===a.objectName}}),Object.defineProperty(AbortSignal,Symbol.hasInstance,{configurable:!0,value(a){return"AbortSignal"===a.objectName}}),Object.defineProperty(FileHandle,Symbol.hasInstance,{configurable:!0,value(a){return"FileHandle"===a.objectName}}),Object.defineProperty(Process,Symbol.hasInstance,{configurable:!0,value(a){return"Process"===a.objectName}}),Object.defineProperty(URL,Symbol.hasInstance,{configurable:!0,value(a){return Object.prototype.toString.call(a).endsWith("URL]")}});
 Math.clamp=function(a,b,c){return Math.min(c,Math.max(b,a))},Math.constrain=Math.clamp,Math.roundTo=function(a,b){return Math.round(a*Math.pow(10,b))/Math.pow(10,b)},Math.toDegrees=function(a){return 180*a/Math.PI},Math.toRadians=function(a){return a/180*Math.PI},Math.percentOfRange=function(a,b,c){return .01*(c-b)*Math.abs(a)+b},Math.rangeValueToPercent=function(a,b,c){const d=c-b,e=0==d?100:100/d;return(a-b)*e};var abs=Math.abs,acos=Math.acos,acosh=Math.acosh,asin=Math.asin,asinh=Math.asinh,atan=Math.atan,atan2=Math.atan2,atanh=Math.atanh,cbrt=Math.cbrt,ceil=Math.ceil,clz32=Math.clz32,cos=Math.cos,cosh=Math.cosh,exp=Math.exp,expm1=Math.expm1,floor=Math.floor,fround=Math.fround,hypot=Math.hypot,imul=Math.imul,log=Math.log,log10=Math.log10,log1p=Math.log1p,log2=Math.log2,max=Math.max,min=Math.min,pow=Math.pow,random=Math.random,round=Math.round,sign=Math.sign,sin=Math.sin,sinh=Math.sinh,sqrt=Math.sqrt,tan=Math.tan,tanh=Math.tanh,trunc=Math.trunc,clamp=Math.clamp,constrain=Math.constrain,roundTo=Math.roundTo,toDegrees=Math.toDegrees,toRadians=Math.toRadians,percentOfRange=Math.percentOfRange,rangeValueToPercent=Math.rangeValueToPercent;
 Number.prototype.round=function(a=0){return Math.roundTo(this,a)},Number.prototype.clamp=function(a,b){return Math.clamp(this,a,b)},Number.prototype.constrain=Number.prototype.clamp;
 Promise.prototype.finally=function(a){var b=this,c=b.constructor;return"function"==typeof a?b.then(function(b){return c.resolve(a()).then(function(){return b})},function(b){return c.resolve(a()).then(function(){throw b})}):b.then(a,a)};
-var sprintf=function(){"use strict";const a=arguments;let b=0;const c=a[b++],d=function(a,b,c,d){c||(c=" ");const e=a.length>=b?"":Array(1+b-a.length>>>0).join(c);return d?a+e:e+a},e=function(a,b,c,e,f){const g=e-a.length;return 0<g&&(c||"0"!==f?a=d(a,e,f,c):a=[a.slice(0,b.length),d("",g,"0",!0),a.slice(b.length)].join("")),a},f=function(a,b,c,f,g,h){const i=a>>>0;return a=d(i.toString(b),g||0,"0",!1),e(a,"",c,f,h)},g=function(a,b,c,d,f){return null!==d&&void 0!==d&&(a=a.slice(0,d)),e(a,"",b,c,f)},h=function(c,h,i,k,m,n){let o,p,q,r,s;if("%%"===c)return"%";let t,u,v=" ",w=!1,x="";for(t=0,u=i.length;t<u;t++)switch(i.charAt(t)){case" ":case"0":v=i.charAt(t);break;case"+":x="+";break;case"-":w=!0;break;case"'":t+1<u&&(v=i.charAt(t+1),t++);}if(k=k?+k:0,!isFinite(k))throw new Error("Width must be finite");if(m=m?+m:"d"===n?0:-1<"fFeE".indexOf(n)?6:void 0,h&&0==+h)throw new Error("Argument number must be greater than zero");if(h&&+h>=a.length)throw new Error("Too few arguments");return s=h?a[+h]:a[b++],"%"===n?"%":"s"===n?g(s+"",w,k,m,v):"c"===n?g(String.fromCharCode(+s),w,k,m,v):"b"===n?f(s,2,w,k,m,v):"o"===n?f(s,8,w,k,m,v):"x"===n?f(s,16,w,k,m,v):"X"===n?f(s,16,w,k,m,v).toUpperCase():"u"===n?f(s,10,w,k,m,v):"i"===n||"d"===n?(o=+s||0,o=Math.round(o-o%1),p=0>o?"-":x,s=p+d(Math.abs(o)+"",m,"0",!1),w&&"0"===v&&(v=" "),e(s,p,w,k,v)):"e"===n||"E"===n||"f"===n||"F"===n||"g"===n||"G"===n?(o=+s,p=0>o?"-":x,q=["toExponential","toFixed","toPrecision"]["efg".indexOf(n.toLowerCase())],r=["toString","toUpperCase"]["eEfFgG".indexOf(n)%2],s=p+Math.abs(o)[q](m),e(s,p,w,k,v)[r]()):""};try{return c.replace(/%%|%(?:(\d+)\$)?((?:[-+#0 ]|'[\s\S])*)(\d+)?(?:\.(\d*))?([\s\S])/g,h)}catch(a){return!1}};
 String.prototype.simplified=function(){return Util.stringSimplify(this)},String.prototype.trimStart=function(){return Util.stringTrimLeft(this)},String.prototype.trimEnd=function(){return Util.stringTrimRight(this)},String.prototype.appendLine=function(a,b,c="\n"){return Util.appendLine(this,a,b,c)},String.prototype.getLines=function(a,b=0,c="\n"){return Util.getLines(this,a,b,c)},String.appendLine=function(a,b,c,d="\n"){return Util.appendLine(a,b,c,d)},String.getLines=function(a,b,c,d="\n"){return Util.getLines(a,c,fromLine,d)};
-var Sffjs=function(){"use strict";function a(a,b){for(var c=""+a;c.length<b;)c="0"+c;return c}function b(a){return null!=a}function c(a,b){return isNaN(a)?b:a}function d(a){for(var b in r)r.hasOwnProperty(b)&&null==a[b]&&(a[b]=r[b]);return a.f=a.f||a.D+" "+a.t,a.F=a.F||a.D+" "+a.T,a.g=a.g||a.d+" "+a.t,a.G=a.G||a.d+" "+a.T,a.m=a.M,a.y=a.Y,a}function e(){q.LC=p=t&&(u[t.toUpperCase()]||u[t.split("-")[0].toUpperCase()])||s}function f(a){var b=a.split("e"),c=b[0];if(1<b.length){var d=+b[1];if(c=c.replace(".",""),0>d){for(;0>++d;)c="0"+c;c="0."+c}else for(;d>=c.length;)c+="0"}return c}function g(a,b){var c=f(Math.abs(a).toString()),d=c.indexOf(".");return 0<d&&c.length-d-1>b&&(c=f((+(c+"1")).toFixed(b)),0<b&&(c=c.replace(/\.?0+$/,""))),c}function h(a){var b=a.indexOf(".");return 0>b?a.length:b}function j(a){var b=a.indexOf(".");return 0>b?0:a.length-b-1}function k(a,c){if(b(c)){var d=/(\.([a-zA-Z_$]\w*)|\[(\d+)\])/g,e=/^[a-zA-Z_$]\w*/.exec(a);for(c=c[e[0]];b(c)&&(e=d.exec(a));)c=c[e[2]||+e[3]]}return c}function l(a,b){for(var c=0,d=b.length;c<d;c++)a.push(b[c]),1<a.g&&1==a.g--%3&&a.push(a.t)}function m(a,c,d,e){var f,g,h=parseInt(a,10),i="";if(isNaN(h))f=k(a,e[1]);else{if(h>e.length-2)throw"Missing argument";f=e[h+1]}for(f=b(f)?f.__Format?f.__Format(d):""+f:"",c=+c||0,g=Math.abs(c)-f.length;0<g--;)i+=" ";return 0>c?f+i:i+f}function n(a,b,c,d,e,f){var i,k,m=[];for(m.t=f,0>a&&m.push("-"),a=g(a,d),i=m.g=h(a),k=j(a),b-=i;0<b--;)l(m,"0");if(l(m,a.substr(0,i)),c||k)for(m.push(e),l(m,a.substr(i+1)),c-=k;0<c--;)l(m,"0");return m.join("")}function o(a,b,c,d){var e,f,i,j,k=0,m=-1,n=-1,o=0,p=-1,q=1,r=0,s=1,t=[],u=[t],v=[];for(i=0;i<b.length;i++)if(e=b[i],"'"==e||"\""==e){if(j=b.indexOf(e,i+1),t.push(new String(b.substring(i+1,0>j?void 0:j))),0>j)break;i=j}else if("\\"==e)t.push(new String(b[++i]));else if(";"==e){if(0<a||0>a&&1<u.length)break;u.push(t=[])}else t.push(e);for(0>a&&1<u.length?(a*=-1,b=u[1]):b=u[!a&&2<u.length?2:0],i=0;i<b.length;i++)e=b[i],"0"===e||"#"===e?(o+=r,"0"==e&&(r?p=o:0>m&&(m=k)),1!=q&&!r&&(v.t=d,q=1),k+=!r):"."===e?r=1:","===e&&!r&&0<k?q*=.001:"%"===e&&(a*=100);for(m=0>m?1:k-m,0>a&&v.push("-"),a=g(a*q,o),n=h(a),f=n-k,v.g=Math.max(n,m),i=0;i<b.length;i++)e=b[i],"#"===e||"0"===e?(f<n?(0<=f?(s&&l(v,a.substr(0,f)),l(v,a[f])):f>=n-m&&l(v,"0"),s=0):(0<p--||f<a.length)&&l(v,f>=a.length?"0":a[f]),f++):"."===e?(a.length>++f||0<p)&&v.push(c):","!==e&&v.push(e);return v.join("")}var p,q={version:"1.17.0",setCulture:function(a){t=a,e()},registerCulture:function(a){u[a.name["toUpperCase"]()]=d(a),e()},getCultures:function(){var a=[s];for(var b in u)a.push(u[b]);return a}},r={name:"",d:"MM/dd/yyyy",D:"dddd, dd MMMM yyyy",t:"HH:mm",T:"HH:mm:ss",M:"MMMM dd",Y:"yyyy MMMM",s:"yyyy-MM-ddTHH:mm:ss",_M:["January","February","March","April","May","June","July","August","September","October","November","December"],_D:["Sunday","Monday","Tuesday","Wednesday","Thursday","Friday","Saturday"],_r:".",_t:",",_c:"\xA4#,0.00",_ct:",",_cr:".",_am:"AM",_pm:"PM"},s=d({}),t="undefined"!=typeof navigator&&(navigator.systemLanguage||navigator.language)||"",u=Object.create(null);Number.prototype.__Format=function(a){var b=+this,d=p._r,e=p._t;if(!isFinite(b))return""+b;a||"0"===a||(a="G");var f=a.match(/^([a-zA-Z])(\d{0,2})$/);if(f){var g=f[1].toUpperCase(),h=parseInt(f[2],10);switch(g){case"D":return n(b,c(h,1),0,0);case"F":e="";case"N":return n(b,1,c(h,2),c(h,2),d,e);case"G":case"E":for(var i=0,j=Math.abs(b);10<=j;)j/=10,i++;for(;0<j&&1>j;)j*=10,i--;var k,l,m=f[1],q=3;if("G"==g){if(h=h||15,-5<i&&i<h)return n(b,1,0,h-i-1,d);m="G"==m?"E":"e",q=2,k=0,l=h-1}else k=l=c(h,6);return 0<=i&&(m+="+"),0>b&&(j*=-1),n(j,1,k,l,d,e)+m+n(i,q,0,0);case"P":return n(100*b,1,c(h,2),c(h,2),d,e)+" %";case"X":var r=Math.round(b).toString(16);for("X"==f[1]&&(r=r.toUpperCase()),h-=r.length;0<h--;)r="0"+r;return r;case"C":a=p._c,d=p._cr,e=p._ct;break;case"R":return""+b;}}return o(b,a,d,e)},Date.prototype.__Format=function(b){var c=this,d=c.getFullYear(),e=c.getMonth(),f=c.getDate(),h=c.getDay(),i=c.getHours(),j=c.getMinutes(),k=c.getSeconds(),l=c.getMilliseconds()/1e3,m=c.getTimezoneOffset(),n=0>m?-m:m;return b=b||"G",1==b.length&&(b=p[b]||b),b.replace(/^%/,"").replace(/(\\.|'[^']*'|"[^"]*"|d{1,4}|M{1,4}|y+|HH?|hh?|mm?|ss?|[f]{1,7}|[F]{1,7}|z{1,3}|tt?)/g,function(b){var c=b[0];return"dddd"==b?p._D[h]:"ddd"==b?p._d?p._d[h]:p._D[h].substr(0,3):"d"==c?a(f,b.length):"MMMM"==b?p._M[e]:"MMM"==b?p._m?p._m[e]:p._M[e].substr(0,3):"M"==c?a(e+1,b.length):"yy"==b?a(d%100,2):"y"==b?d%100:"y"==c?a(d,b.length):"H"==c?a(i,b.length):"h"==c?a(i%12||12,b.length):"m"==c?a(j,b.length):"s"==c?a(k,b.length):"f"==c?l.toFixed(b.length).substr(2):"F"==c?g(l,b.length).substr(2):"z"==c?(0>m?"-":"+")+a(0|n/60,"z"==b?1:2)+("zzz"==b?":"+a(n%60,2):""):"tt"==b?12>i?p._am:p._pm:"t"==c?(12>i?p._am:p._pm)[0]:b.substr(1,b.length-1-("\\"!=b[0]))})},String.__Format=function(a){var b=arguments;return a.replace(/\{((\d+|[a-zA-Z_$]\w*(?:\.[a-zA-Z_$]\w*|\[\d+\])*)(?:\,(-?\d*))?(?:\:([^\}]*(?:(?:\}\})+[^\}]+)*))?)\}|(\{\{)|(\}\})/g,function(){var a=arguments;return a[5]?"{":a[6]?"}":m(a[2],a[3],a[4]&&a[4].replace(/\}\}/g,"}").replace(/\{\{/g,"{"),b)})};for(var v=[Date.prototype,Number.prototype,String],w=0,x=v.length;w<x;w++)v[w].format=v[w].format||v[w].__Format;return e(),q}(),Format=String.__Format;
\ No newline at end of file
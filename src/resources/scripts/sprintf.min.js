@@ -0,0 +1 @@
+var sprintf=function(){"use strict";const a=arguments;let b=0;const c=a[b++],d=function(a,b,c,d){c||(c=" ");const e=a.length>=b?"":Array(1+b-a.length>>>0).join(c);return d?a+e:e+a},e=function(a,b,c,e,f){const g=e-a.length;return 0<g&&(c||"0"!==f?a=d(a,e,f,c):a=[a.slice(0,b.length),d("",g,"0",!0),a.slice(b.length)].join("")),a},f=function(a,b,c,f,g,h){const i=a>>>0;return a=d(i.toString(b),g||0,"0",!1),e(a,"",c,f,h)},g=function(a,b,c,d,f){return null!==d&&void 0!==d&&(a=a.slice(0,d)),e(a,"",b,c,f)},h=function(c,h,i,k,m,n){let o,p,q,r,s;if("%%"===c)return"%";let t,u,v=" ",w=!1,x="";for(t=0,u=i.length;t<u;t++)switch(i.charAt(t)){case" ":case"0":v=i.charAt(t);break;case"+":x="+";break;case"-":w=!0;break;case"'":t+1<u&&(v=i.charAt(t+1),t++);}if(k=k?+k:0,!isFinite(k))throw new Error("Width must be finite");if(m=m?+m:"d"===n?0:-1<"fFeE".indexOf(n)?6:void 0,h&&0==+h)throw new Error("Argument number must be greater than zero");if(h&&+h>=a.length)throw new Error("Too few arguments");return s=h?a[+h]:a[b++],"%"===n?"%":"s"===n?g(s+"",w,k,m,v):"c"===n?g(String.fromCharCode(+s),w,k,m,v):"b"===n?f(s,2,w,k,m,v):"o"===n?f(s,8,w,k,m,v):"x"===n?f(s,16,w,k,m,v):"X"===n?f(s,16,w,k,m,v).toUpperCase():"u"===n?f(s,10,w,k,m,v):"i"===n||"d"===n?(o=+s||0,o=Math.round(o-o%1),p=0>o?"-":x,s=p+d(Math.abs(o)+"",m,"0",!1),w&&"0"===v&&(v=" "),e(s,p,w,k,v)):"e"===n||"E"===n||"f"===n||"F"===n||"g"===n||"G"===n?(o=+s,p=0>o?"-":x,q=["toExponential","toFixed","toPrecision"]["efg".indexOf(n.toLowerCase())],r=["toString","toUpperCase"]["eEfFgG".indexOf(n)%2],s=p+Math.abs(o)[q](m),e(s,p,w,k,v)[r]()):""};try{return c.replace(/%%|%(?:(\d+)\$)?((?:[-+#0 ]|'[\s\S])*)(\d+)?(?:\.(\d*))?([\s\S])/g,h)}catch(a){return!1}};
@@ -0,0 +1 @@
+var Sffjs=function(){"use strict";function a(a,b){for(var c=""+a;c.length<b;)c="0"+c;return c}function b(a){return null!=a}function c(a,b){return isNaN(a)?b:a}function d(a){for(var b in r)r.hasOwnProperty(b)&&null==a[b]&&(a[b]=r[b]);return a.f=a.f||a.D+" "+a.t,a.F=a.F||a.D+" "+a.T,a.g=a.g||a.d+" "+a.t,a.G=a.G||a.d+" "+a.T,a.m=a.M,a.y=a.Y,a}function e(){q.LC=p=t&&(u[t.toUpperCase()]||u[t.split("-")[0].toUpperCase()])||s}function f(a){var b=a.split("e"),c=b[0];if(1<b.length){var d=+b[1];if(c=c.replace(".",""),0>d){for(;0>++d;)c="0"+c;c="0."+c}else for(;d>=c.length;)c+="0"}return c}function g(a,b){var c=f(Math.abs(a).toString()),d=c.indexOf(".");return 0<d&&c.length-d-1>b&&(c=f((+(c+"1")).toFixed(b)),0<b&&(c=c.replace(/\.?0+$/,""))),c}function h(a){var b=a.indexOf(".");return 0>b?a.length:b}function j(a){var b=a.indexOf(".");return 0>b?0:a.length-b-1}function k(a,c){if(b(c)){var d=/(\.([a-zA-Z_$]\w*)|\[(\d+)\])/g,e=/^[a-zA-Z_$]\w*/.exec(a);for(c=c[e[0]];b(c)&&(e=d.exec(a));)c=c[e[2]||+e[3]]}return c}function l(a,b){for(var c=0,d=b.length;c<d;c++)a.push(b[c]),1<a.g&&1==a.g--%3&&a.push(a.t)}function m(a,c,d,e){var f,g,h=parseInt(a,10),i="";if(isNaN(h))f=k(a,e[1]);else{if(h>e.length-2)throw"Missing argument";f=e[h+1]}for(f=b(f)?f.__Format?f.__Format(d):""+f:"",c=+c||0,g=Math.abs(c)-f.length;0<g--;)i+=" ";return 0>c?f+i:i+f}function n(a,b,c,d,e,f){var i,k,m=[];for(m.t=f,0>a&&m.push("-"),a=g(a,d),i=m.g=h(a),k=j(a),b-=i;0<b--;)l(m,"0");if(l(m,a.substr(0,i)),c||k)for(m.push(e),l(m,a.substr(i+1)),c-=k;0<c--;)l(m,"0");return m.join("")}function o(a,b,c,d){var e,f,i,j,k=0,m=-1,n=-1,o=0,p=-1,q=1,r=0,s=1,t=[],u=[t],v=[];for(i=0;i<b.length;i++)if(e=b[i],"'"==e||"\""==e){if(j=b.indexOf(e,i+1),t.push(new String(b.substring(i+1,0>j?void 0:j))),0>j)break;i=j}else if("\\"==e)t.push(new String(b[++i]));else if(";"==e){if(0<a||0>a&&1<u.length)break;u.push(t=[])}else t.push(e);for(0>a&&1<u.length?(a*=-1,b=u[1]):b=u[!a&&2<u.length?2:0],i=0;i<b.length;i++)e=b[i],"0"===e||"#"===e?(o+=r,"0"==e&&(r?p=o:0>m&&(m=k)),1!=q&&!r&&(v.t=d,q=1),k+=!r):"."===e?r=1:","===e&&!r&&0<k?q*=.001:"%"===e&&(a*=100);for(m=0>m?1:k-m,0>a&&v.push("-"),a=g(a*q,o),n=h(a),f=n-k,v.g=Math.max(n,m),i=0;i<b.length;i++)e=b[i],"#"===e||"0"===e?(f<n?(0<=f?(s&&l(v,a.substr(0,f)),l(v,a[f])):f>=n-m&&l(v,"0"),s=0):(0<p--||f<a.length)&&l(v,f>=a.length?"0":a[f]),f++):"."===e?(a.length>++f||0<p)&&v.push(c):","!==e&&v.push(e);return v.join("")}var p,q={version:"1.17.0",setCulture:function(a){t=a,e()},registerCulture:function(a){u[a.name["toUpperCase"]()]=d(a),e()},getCultures:function(){var a=[s];for(var b in u)a.push(u[b]);return a}},r={name:"",d:"MM/dd/yyyy",D:"dddd, dd MMMM yyyy",t:"HH:mm",T:"HH:mm:ss",M:"MMMM dd",Y:"yyyy MMMM",s:"yyyy-MM-ddTHH:mm:ss",_M:["January","February","March","April","May","June","July","August","September","October","November","December"],_D:["Sunday","Monday","Tuesday","Wednesday","Thursday","Friday","Saturday"],_r:".",_t:",",_c:"\xA4#,0.00",_ct:",",_cr:".",_am:"AM",_pm:"PM"},s=d({}),t="undefined"!=typeof navigator&&(navigator.systemLanguage||navigator.language)||"",u=Object.create(null);Number.prototype.__Format=function(a){var b=+this,d=p._r,e=p._t;if(!isFinite(b))return""+b;a||"0"===a||(a="G");var f=a.match(/^([a-zA-Z])(\d{0,2})$/);if(f){var g=f[1].toUpperCase(),h=parseInt(f[2],10);switch(g){case"D":return n(b,c(h,1),0,0);case"F":e="";case"N":return n(b,1,c(h,2),c(h,2),d,e);case"G":case"E":for(var i=0,j=Math.abs(b);10<=j;)j/=10,i++;for(;0<j&&1>j;)j*=10,i--;var k,l,m=f[1],q=3;if("G"==g){if(h=h||15,-5<i&&i<h)return n(b,1,0,h-i-1,d);m="G"==m?"E":"e",q=2,k=0,l=h-1}else k=l=c(h,6);return 0<=i&&(m+="+"),0>b&&(j*=-1),n(j,1,k,l,d,e)+m+n(i,q,0,0);case"P":return n(100*b,1,c(h,2),c(h,2),d,e)+" %";case"X":var r=Math.round(b).toString(16);for("X"==f[1]&&(r=r.toUpperCase()),h-=r.length;0<h--;)r="0"+r;return r;case"C":a=p._c,d=p._cr,e=p._ct;break;case"R":return""+b;}}return o(b,a,d,e)},Date.prototype.__Format=function(b){var c=this,d=c.getFullYear(),e=c.getMonth(),f=c.getDate(),h=c.getDay(),i=c.getHours(),j=c.getMinutes(),k=c.getSeconds(),l=c.getMilliseconds()/1e3,m=c.getTimezoneOffset(),n=0>m?-m:m;return b=b||"G",1==b.length&&(b=p[b]||b),b.replace(/^%/,"").replace(/(\\.|'[^']*'|"[^"]*"|d{1,4}|M{1,4}|y+|HH?|hh?|mm?|ss?|[f]{1,7}|[F]{1,7}|z{1,3}|tt?)/g,function(b){var c=b[0];return"dddd"==b?p._D[h]:"ddd"==b?p._d?p._d[h]:p._D[h].substr(0,3):"d"==c?a(f,b.length):"MMMM"==b?p._M[e]:"MMM"==b?p._m?p._m[e]:p._M[e].substr(0,3):"M"==c?a(e+1,b.length):"yy"==b?a(d%100,2):"y"==b?d%100:"y"==c?a(d,b.length):"H"==c?a(i,b.length):"h"==c?a(i%12||12,b.length):"m"==c?a(j,b.length):"s"==c?a(k,b.length):"f"==c?l.toFixed(b.length).substr(2):"F"==c?g(l,b.length).substr(2):"z"==c?(0>m?"-":"+")+a(0|n/60,"z"==b?1:2)+("zzz"==b?":"+a(n%60,2):""):"tt"==b?12>i?p._am:p._pm:"t"==c?(12>i?p._am:p._pm)[0]:b.substr(1,b.length-1-("\\"!=b[0]))})},String.__Format=function(a){var b=arguments;return a.replace(/\{((\d+|[a-zA-Z_$]\w*(?:\.[a-zA-Z_$]\w*|\[\d+\])*)(?:\,(-?\d*))?(?:\:([^\}]*(?:(?:\}\})+[^\}]+)*))?)\}|(\{\{)|(\}\})/g,function(){var a=arguments;return a[5]?"{":a[6]?"}":m(a[2],a[3],a[4]&&a[4].replace(/\}\}/g,"}").replace(/\{\{/g,"{"),b)})};for(var v=[Date.prototype,Number.prototype,String],w=0,x=v.length;w<x;w++)v[w].format=v[w].format||v[w].__Format;return e(),q}(),Format=String.__Format;
\ No newline at end of file
@@ -52,13 +52,17 @@ static inline void runOnThreadSync(QThread *qThread, Func &&func)
 {
 	QMutex m;
 	QWaitCondition wc;
-	runOnThread(qThread, [=, &wc]() {
+	bool done = false;
+	runOnThread(qThread, [=, &m, &wc, &done]() {
 		func();
+		QMutexLocker l(&m);
+		done = true;
 		wc.notify_all();
 	});
-	m.lock();
-	wc.wait(&m);
-	m.unlock();
+	// the function may already be done by the time we get here, so don't wait for a notification which already happened
+	QMutexLocker l(&m);
+	while (!done)
+		wc.wait(&m);
 }
 
 // unpacks an value which is a JS array into a list of individual JS values